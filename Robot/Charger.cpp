@@ -1,6 +1,6 @@
 #include "Charger.h"
 
-Charger::Charger(size_t id) : Tile(id) {}
+Charger::Charger() : Tile(TileKind::charger) {}
 
 std::unique_ptr<Tile> Charger::clone() const {
     return std::make_unique<Charger>(*this);
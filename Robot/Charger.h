@@ -3,7 +3,7 @@
 
 class Charger : public Tile {
 public:
-    Charger(size_t id = 0);
+    Charger();
 
     std::unique_ptr<Tile> clone() const override;
     bool isMoveValid() const override;
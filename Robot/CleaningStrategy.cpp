@@ -0,0 +1,44 @@
+#include "CleaningStrategy.h"
+#include "GreedyStrategy.h"
+#include "DirtPerDistanceStrategy.h"
+#include "FrontierFirstStrategy.h"
+#include "MctsStrategy.h"
+#include <stack>
+
+CleaningStrategy::SearchTree& CleaningStrategy::threadSearchTree() {
+    thread_local SearchTree tree;
+    return tree;
+}
+
+void CleaningStrategy::setPath(Robot& robot, const SearchTree& tree, size_t target) {
+    std::stack<size_t> tempStack;
+    for (size_t v = target; v != robot.position_; v = tree.parent[v]) {
+        tempStack.push(v);
+    }
+    robot.path.reset(robot.position_, robot.map.getWidth(), robot.map.getSize());
+    while (!tempStack.empty()) {
+        robot.path.push(tempStack.top());
+        tempStack.pop();
+    }
+}
+
+std::vector<std::string> cleaningStrategyNames() {
+    return { GreedyStrategy().getName(), DirtPerDistanceStrategy().getName(), FrontierFirstStrategy().getName(),
+        MctsStrategy().getName() };
+}
+
+std::shared_ptr<const CleaningStrategy> makeCleaningStrategy(const std::string& name) {
+    if (name == GreedyStrategy().getName()) {
+        return std::make_shared<GreedyStrategy>();
+    }
+    if (name == DirtPerDistanceStrategy().getName()) {
+        return std::make_shared<DirtPerDistanceStrategy>();
+    }
+    if (name == FrontierFirstStrategy().getName()) {
+        return std::make_shared<FrontierFirstStrategy>();
+    }
+    if (name == MctsStrategy().getName()) {
+        return std::make_shared<MctsStrategy>();
+    }
+    return nullptr;
+}
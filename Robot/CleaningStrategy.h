@@ -0,0 +1,89 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <utility>
+#include <string>
+#include <vector>
+#include <limits>
+#include "Robot.h"
+
+// Strategia wyboru kolejnego celu w trybie sprzątania.
+// Robot deleguje do niej decyzję, gdy nie ma nic do sprzątnięcia na bieżącym kafelku.
+class CleaningStrategy {
+public:
+    virtual ~CleaningStrategy() = default;
+
+    virtual const char* getName() const noexcept = 0;
+    // Prepares the robot's path; returns the task to continue with, nullopt if there is nothing to do
+    virtual std::optional<RobotAction> plan(Robot& robot) const = 0;
+
+protected:
+    static constexpr TileIndex NO_PARENT = NO_TILE;
+
+    // Access to the robot planners shared by all strategies
+    static const Map& memory(const Robot& robot) { return robot.map; }
+    static size_t position(const Robot& robot) { return robot.position_; }
+    static bool hasPath(Robot& robot) { return robot.hasPath(); }
+    static bool isClaimed(const Robot& robot, size_t tile) { return robot.isClaimed(tile); }
+    static bool createPath(Robot& robot, size_t target) { return robot.createPath(target); }
+    static bool createPathTrash(Robot& robot) { return robot.createPathTrash(); }
+    static bool createPathToVisit(Robot& robot) { return robot.createPathToVisit(); }
+    static bool createPathUnvisited(Robot& robot) { return robot.createPathUnvisited(); }
+    static bool createPathDirtyNeighbour(Robot& robot) { return robot.createPathDirtyNeighbour(); }
+    static bool createPathToCharger(Robot& robot) { return robot.createPathToCharger(); }
+
+    // Bufory przeszukiwania wszerz wspólne dla kolejnych decyzji w wątku; kafelek został osiągnięty
+    // w bieżącym wyszukiwaniu, gdy jego znacznik równa się numerowi wyszukiwania
+    struct SearchTree {
+        std::vector<uint32_t> stamp;
+        std::vector<TileIndex> parent;
+        std::vector<std::pair<TileIndex, uint32_t>> queue; // (tile, distance)
+        uint32_t search = 0;
+    };
+    // Buffers of the calling thread
+    static SearchTree& threadSearchTree();
+
+    // Breadth-first search over walkable remembered tiles starting at the robot.
+    // visit(tile, distance) returns true to stop; parent of every reached tile is stored in tree.
+    template <typename Visit>
+    static void searchFrom(const Robot& robot, SearchTree& tree, Visit&& visit);
+    // Replaces the robot path with the route to target recorded by searchFrom
+    static void setPath(Robot& robot, const SearchTree& tree, size_t target);
+};
+
+// Strategy names accepted by makeCleaningStrategy
+std::vector<std::string> cleaningStrategyNames();
+// Returns nullptr for an unknown name
+std::shared_ptr<const CleaningStrategy> makeCleaningStrategy(const std::string& name);
+
+template <typename Visit>
+void CleaningStrategy::searchFrom(const Robot& robot, SearchTree& tree, Visit&& visit) {
+    const Map& map = memory(robot);
+    const size_t size = map.getSize();
+    if (tree.stamp.size() != size || tree.search == UINT32_MAX) {
+        tree.stamp.assign(size, 0);
+        tree.parent.resize(size);
+        tree.search = 0;
+    }
+    const uint32_t search = ++tree.search;
+
+    const TileIndex start = static_cast<TileIndex>(position(robot));
+    tree.stamp[start] = search;
+    tree.parent[start] = start;
+    tree.queue.clear();
+    tree.queue.push_back({ start, 0 });
+    for (size_t head = 0; head < tree.queue.size(); ++head) {
+        const auto [current, distance] = tree.queue[head];
+        if (visit(current, distance)) {
+            return;
+        }
+
+        map.forEachWalkableNeighbour(current, [&](size_t neighbour) {
+            if (tree.stamp[neighbour] != search) {
+                tree.stamp[neighbour] = search;
+                tree.parent[neighbour] = current;
+                tree.queue.push_back({ static_cast<TileIndex>(neighbour), distance + 1 });
+            }
+        });
+    }
+}
@@ -0,0 +1,210 @@
+#include "CoveragePlanner.h"
+#include <algorithm>
+#include <queue>
+
+CoveragePlanner::CoveragePlanner(const Map& memoryMap) : map(memoryMap) {}
+
+std::vector<uint8_t> CoveragePlanner::reachableFrom(size_t start) const {
+    std::vector<uint8_t> reachable(map.getSize(), 0);
+    if (!map.canMoveOn(start)) {
+        return reachable;
+    }
+
+    std::queue<size_t> q;
+    reachable[start] = 1;
+    q.push(start);
+    while (!q.empty()) {
+        size_t current = q.front();
+        q.pop();
+        map.forEachWalkableNeighbour(current, [&](size_t neighbour) {
+            if (!reachable[neighbour]) {
+                reachable[neighbour] = 1;
+                q.push(neighbour);
+            }
+        });
+    }
+    return reachable;
+}
+
+void CoveragePlanner::decompose(size_t start) {
+    cells.clear();
+    const size_t width = map.getWidth();
+    const size_t height = map.getHeight();
+    std::vector<uint8_t> reachable = reachableFrom(start);
+
+    // Odcinki poprzedniej kolumny z numerem komórki i liczbą nakładających się odcinków bieżącej
+    std::vector<Segment> previous;
+    std::vector<uint32_t> previousCell;
+    std::vector<Segment> column;
+    std::vector<uint32_t> columnCell;
+
+    for (size_t x = 0; x < width; ++x) {
+        column.clear();
+        for (size_t y = 0; y < height; ++y) {
+            if (!reachable[y * width + x]) {
+                continue;
+            }
+            if (!column.empty() && column.back().bottom + 1 == y) {
+                column.back().bottom = y;
+            }
+            else {
+                column.push_back({ y, y });
+            }
+        }
+
+        // Count overlaps in both directions; a cell continues only on a one-to-one overlap
+        std::vector<uint32_t> previousOverlaps(previous.size(), 0);
+        std::vector<uint32_t> columnOverlaps(column.size(), 0);
+        std::vector<size_t> overlapWith(column.size(), 0);
+        for (size_t i = 0, j = 0; i < column.size() && j < previous.size();) {
+            if (column[i].bottom < previous[j].top) {
+                i++;
+            }
+            else if (previous[j].bottom < column[i].top) {
+                j++;
+            }
+            else {
+                columnOverlaps[i]++;
+                previousOverlaps[j]++;
+                overlapWith[i] = j;
+                if (column[i].bottom < previous[j].bottom) {
+                    i++;
+                }
+                else {
+                    j++;
+                }
+            }
+        }
+
+        columnCell.assign(column.size(), NO_CELL);
+        for (size_t i = 0; i < column.size(); ++i) {
+            if (columnOverlaps[i] == 1 && previousOverlaps[overlapWith[i]] == 1) {
+                columnCell[i] = previousCell[overlapWith[i]];
+                cells[columnCell[i]].segments.push_back(column[i]);
+            }
+            else {
+                columnCell[i] = static_cast<uint32_t>(cells.size());
+                cells.push_back({ x, { column[i] } });
+            }
+        }
+
+        std::swap(previous, column);
+        std::swap(previousCell, columnCell);
+    }
+}
+
+void CoveragePlanner::walkColumn(size_t column, size_t fromRow, size_t toRow, std::vector<size_t>& route) const {
+    const size_t width = map.getWidth();
+    while (fromRow != toRow) {
+        fromRow = fromRow < toRow ? fromRow + 1 : fromRow - 1;
+        route.push_back(fromRow * width + column);
+    }
+}
+
+size_t CoveragePlanner::sweepCell(const Cell& cell, bool fromFirstColumn, bool fromTop, size_t current,
+    std::vector<size_t>& route) const {
+    const size_t width = map.getWidth();
+    const size_t count = cell.segments.size();
+    size_t row = current / width;
+
+    for (size_t step = 0; step < count; ++step) {
+        const size_t index = fromFirstColumn ? step : count - 1 - step;
+        const size_t column = cell.firstColumn + index;
+        const Segment& segment = cell.segments[index];
+
+        if (step > 0) {
+            // Przejście do sąsiedniej kolumny przez wspólny fragment odcinków
+            const Segment& previous = cell.segments[fromFirstColumn ? index - 1 : index + 1];
+            const size_t previousColumn = fromFirstColumn ? column - 1 : column + 1;
+            const size_t crossing = std::clamp(row, std::max(segment.top, previous.top),
+                std::min(segment.bottom, previous.bottom));
+            walkColumn(previousColumn, row, crossing, route);
+            route.push_back(crossing * width + column);
+            row = crossing;
+            fromTop = row - segment.top <= segment.bottom - row;
+        }
+
+        // Najpierw do bliższego końca odcinka, potem do dalszego
+        const size_t nearEnd = fromTop ? segment.top : segment.bottom;
+        const size_t farEnd = fromTop ? segment.bottom : segment.top;
+        walkColumn(column, row, nearEnd, route);
+        walkColumn(column, nearEnd, farEnd, route);
+        row = farEnd;
+    }
+    return row * width + cell.firstColumn + (fromFirstColumn ? count - 1 : 0);
+}
+
+std::vector<size_t> CoveragePlanner::plan(size_t start) {
+    decompose(start);
+    searchCount = 0;
+
+    std::vector<size_t> route;
+    if (cells.empty()) {
+        return route;
+    }
+
+    const size_t width = map.getWidth();
+    // Narożniki komórek, od których można zacząć przejazd: numer komórki * 4 + narożnik
+    std::vector<uint32_t> entry(map.getSize(), NO_CELL);
+    for (size_t c = 0; c < cells.size(); ++c) {
+        const Cell& cell = cells[c];
+        const Segment& first = cell.segments.front();
+        const Segment& last = cell.segments.back();
+        entry[first.top * width + cell.firstColumn] = static_cast<uint32_t>(c * 4 + 0);
+        entry[first.bottom * width + cell.firstColumn] = static_cast<uint32_t>(c * 4 + 1);
+        entry[last.top * width + cell.lastColumn()] = static_cast<uint32_t>(c * 4 + 2);
+        entry[last.bottom * width + cell.lastColumn()] = static_cast<uint32_t>(c * 4 + 3);
+    }
+
+    std::vector<uint8_t> covered(cells.size(), 0);
+    std::vector<TileIndex> parent(map.getSize());
+    // Numer wyszukiwania, w którym kafelek odwiedzono - bez czyszczenia całej tablicy
+    std::vector<uint32_t> visitedIn(map.getSize(), 0);
+    std::queue<TileIndex> q;
+    size_t current = start;
+    size_t remaining = cells.size();
+
+    while (remaining > 0) {
+        // Najbliższy narożnik niepokrytej komórki
+        searchCount++;
+        const uint32_t search = static_cast<uint32_t>(searchCount);
+        q = std::queue<TileIndex>();
+        visitedIn[current] = search;
+        q.push(static_cast<TileIndex>(current));
+        size_t target = current;
+        uint32_t corner = NO_CELL;
+        while (!q.empty()) {
+            size_t tile = q.front();
+            q.pop();
+            if (entry[tile] != NO_CELL && !covered[entry[tile] / 4]) {
+                target = tile;
+                corner = entry[tile];
+                break;
+            }
+            map.forEachWalkableNeighbour(tile, [&](size_t neighbour) {
+                if (visitedIn[neighbour] != search) {
+                    visitedIn[neighbour] = search;
+                    parent[neighbour] = static_cast<TileIndex>(tile);
+                    q.push(static_cast<TileIndex>(neighbour));
+                }
+            });
+        }
+        if (corner == NO_CELL) {
+            break;
+        }
+
+        const size_t routeStart = route.size();
+        for (size_t v = target; v != current; v = parent[v]) {
+            route.push_back(v);
+        }
+        std::reverse(route.begin() + routeStart, route.end());
+
+        const Cell& cell = cells[corner / 4];
+        const bool fromFirstColumn = corner % 4 < 2;
+        const bool fromTop = corner % 2 == 0;
+        current = sweepCell(cell, fromFirstColumn, fromTop, target, route);
+        covered[corner / 4] = 1;
+        remaining--;
+    }
+    return route;
+}
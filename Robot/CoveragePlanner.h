@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+
+// Planer pokrycia: dzieli osiągalne kafelki na komórki (dekompozycja boustrophedon
+// po kolumnach) i łączy je w jedną trasę przejeżdżającą każdą komórkę zygzakiem.
+class CoveragePlanner {
+public:
+    // Pionowy odcinek wolnych kafelków w jednej kolumnie
+    struct Segment {
+        size_t top;
+        size_t bottom;
+    };
+
+    // Komórka to ciąg odcinków w kolejnych kolumnach bez podziałów i złączeń
+    struct Cell {
+        size_t firstColumn;
+        std::vector<Segment> segments;
+
+        size_t lastColumn() const { return firstColumn + segments.size() - 1; }
+    };
+
+private:
+    static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+    const Map& map;
+    std::vector<Cell> cells;
+    size_t searchCount = 0;
+
+    std::vector<uint8_t> reachableFrom(size_t start) const;
+    // Appends the sweep of a cell entered at the given corner, returns the last tile
+    size_t sweepCell(const Cell& cell, bool fromFirstColumn, bool fromTop, size_t current, std::vector<size_t>& route) const;
+    void walkColumn(size_t column, size_t fromRow, size_t toRow, std::vector<size_t>& route) const;
+
+public:
+    explicit CoveragePlanner(const Map& memoryMap);
+
+    // Splits the walkable tiles reachable from start into cells
+    void decompose(size_t start);
+    // Route from start (excluded) over every walkable tile reachable from it
+    std::vector<size_t> plan(size_t start);
+
+    const std::vector<Cell>& getCells() const noexcept { return cells; }
+    // Number of breadth-first searches made by the last plan
+    size_t getSearchCount() const noexcept { return searchCount; }
+};
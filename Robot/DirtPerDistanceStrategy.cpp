@@ -0,0 +1,44 @@
+#include "DirtPerDistanceStrategy.h"
+
+bool DirtPerDistanceStrategy::createPathBestTrash(Robot& robot) {
+    const Map& map = memory(robot);
+    SearchTree& tree = threadSearchTree();
+    size_t best = NO_PARENT;
+    size_t bestDirt = 0;
+    size_t bestDistance = 1;
+
+    searchFrom(robot, tree, [&](size_t tile, size_t distance) {
+        // Tiles this far can't beat the best ratio even with maximum dirt
+        if (best != NO_PARENT && 9 * bestDistance <= bestDirt * distance) {
+            return true;
+        }
+        const Floor* floor = map.getTile(tile)->asFloor();
+        if (distance == 0 || !floor || !floor->isDirty() || isClaimed(robot, tile)) {
+            return false;
+        }
+        // dirt / distance > bestDirt / bestDistance, compared without division
+        const size_t dirt = floor->getCleanliness();
+        if (best == NO_PARENT || dirt * bestDistance > bestDirt * distance) {
+            best = tile;
+            bestDirt = dirt;
+            bestDistance = distance;
+        }
+        return false;
+    });
+
+    if (best == NO_PARENT) {
+        return false;
+    }
+    setPath(robot, tree, best);
+    return true;
+}
+
+std::optional<RobotAction> DirtPerDistanceStrategy::plan(Robot& robot) const {
+    if (hasPath(robot) || createPathBestTrash(robot) || createPathToVisit(robot) || createPathToCharger(robot)) {
+        return RobotAction::clean;
+    }
+    if (createPathUnvisited(robot)) {
+        return RobotAction::explore;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "CleaningStrategy.h"
+
+// Wybiera brud o największym poziomie zabrudzenia na jednostkę odległości
+class DirtPerDistanceStrategy : public CleaningStrategy {
+private:
+    static bool createPathBestTrash(Robot& robot);
+
+public:
+    const char* getName() const noexcept override { return "dirt-per-distance"; }
+    std::optional<RobotAction> plan(Robot& robot) const override;
+};
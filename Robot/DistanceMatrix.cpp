@@ -0,0 +1,202 @@
+#include "DistanceMatrix.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include "Map.h"
+#include "WorkerPool.h"
+
+namespace {
+    // Wątki wspólne dla wszystkich liczonych macierzy; równoległe wywołania czekają na swoją kolej
+    WorkerPool& searchPool() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    constexpr uint32_t NO_TARGET = UINT32_MAX;
+
+    // Dane wspólne dla wszystkich wątków, tylko do odczytu
+    struct SearchInput {
+        const Map* map = nullptr;
+        const uint32_t* firstTarget = nullptr; // Pierwszy cel na kafelku, NO_TARGET jeśli brak
+        std::vector<uint32_t> nextTarget;      // Kolejny cel na tym samym kafelku
+        std::vector<size_t> targetTiles;   // Different tiles among the targets
+        std::vector<size_t> targetComponent;
+    };
+
+    // Bufory jednego wątku używane przez kolejne wyszukiwania i kolejne macierze
+    struct SearchBuffers {
+        // Numer wyszukiwania, które ostatnio odwiedziło kafelek
+        std::vector<uint32_t> visitedIn;
+        std::vector<TileIndex> queue;
+        uint32_t search = 0;
+
+        void prepare(size_t size) {
+            if (visitedIn.size() != size || search == UINT32_MAX) {
+                visitedIn.assign(size, 0);
+                search = 0;
+            }
+        }
+    };
+
+    SearchBuffers& threadBuffers() {
+        thread_local SearchBuffers buffers;
+        return buffers;
+    }
+
+    // Tablica celów wątku wołającego compute; między wywołaniami cała ma wartość NO_TARGET
+    class TargetTable {
+        std::vector<uint32_t>& first;
+        const std::vector<size_t>& tiles;
+
+        static std::vector<uint32_t>& threadTable() {
+            thread_local std::vector<uint32_t> table;
+            return table;
+        }
+
+    public:
+        TargetTable(size_t size, const std::vector<size_t>& targetTiles) : first(threadTable()), tiles(targetTiles) {
+            if (first.size() != size) {
+                first.assign(size, NO_TARGET);
+            }
+        }
+        TargetTable(const TargetTable&) = delete;
+        TargetTable& operator=(const TargetTable&) = delete;
+        // Czyści tylko kafelki celów, także gdy liczenie przerwał wyjątek
+        ~TargetTable() {
+            for (size_t tile : tiles) {
+                first[tile] = NO_TARGET;
+            }
+        }
+
+        uint32_t& operator[](size_t tile) { return first[tile]; }
+        const uint32_t* data() const noexcept { return first.data(); }
+    };
+
+    size_t searchFrom(const SearchInput& in, SearchBuffers& buffers, size_t source, size_t component, uint32_t* row) {
+        // Early termination: count the target tiles this search can reach at all
+        size_t remaining = 0;
+        for (size_t i = 0; i < in.targetTiles.size(); ++i) {
+            if (component == Map::NO_COMPONENT || in.targetComponent[i] == component || in.targetTiles[i] == source) {
+                remaining++;
+            }
+        }
+
+        buffers.prepare(in.map->getSize());
+        const uint32_t search = ++buffers.search;
+        std::vector<TileIndex>& queue = buffers.queue;
+        queue.clear();
+        queue.push_back(static_cast<TileIndex>(source));
+        // Nieprzejezdne źródło (np. robot na kafelku, który zmienił się w przeszkodę) też startuje
+        buffers.visitedIn[source] = search;
+        size_t head = 0;
+        uint32_t distance = 0;
+        size_t levelEnd = queue.size();
+
+        while (head < queue.size() && remaining > 0) {
+            if (head == levelEnd) {
+                distance++;
+                levelEnd = queue.size();
+            }
+            const size_t tile = queue[head++];
+            if (in.firstTarget[tile] != NO_TARGET) {
+                for (uint32_t t = in.firstTarget[tile]; t != NO_TARGET; t = in.nextTarget[t]) {
+                    row[t] = distance;
+                }
+                remaining--;
+            }
+
+            in.map->forEachWalkableNeighbour(tile, [&](size_t neighbour) {
+                if (buffers.visitedIn[neighbour] != search) {
+                    buffers.visitedIn[neighbour] = search;
+                    queue.push_back(static_cast<TileIndex>(neighbour));
+                }
+            });
+        }
+        return head;
+    }
+}
+
+DistanceMatrix DistanceMatrix::compute(const Map& map, const std::vector<size_t>& sourceTiles,
+    const std::vector<size_t>& targetTiles, unsigned threads) {
+    const size_t size = map.getSize();
+    for (size_t tile : sourceTiles) {
+        if (tile >= size) {
+            throw std::out_of_range("Distance source outside the map: " + std::to_string(tile));
+        }
+    }
+    for (size_t tile : targetTiles) {
+        if (tile >= size) {
+            throw std::out_of_range("Distance target outside the map: " + std::to_string(tile));
+        }
+    }
+
+    DistanceMatrix result;
+    result.sources = sourceTiles.size();
+    result.targets = targetTiles.size();
+    result.distances.assign(result.sources * result.targets, UNREACHABLE);
+    if (result.distances.empty()) {
+        return result;
+    }
+
+    SearchInput in;
+    in.map = &map;
+    in.nextTarget.assign(targetTiles.size(), NO_TARGET);
+    TargetTable firstTarget(size, targetTiles);
+    in.firstTarget = firstTarget.data();
+    for (size_t t = targetTiles.size(); t-- > 0;) {
+        const size_t tile = targetTiles[t];
+        if (firstTarget[tile] == NO_TARGET) {
+            in.targetTiles.push_back(tile);
+        }
+        in.nextTarget[t] = firstTarget[tile];
+        firstTarget[tile] = static_cast<uint32_t>(t);
+    }
+
+    // Etykiety składowych liczone przed wątkami - mapa przebudowuje je leniwie
+    in.targetComponent.reserve(in.targetTiles.size());
+    for (size_t tile : in.targetTiles) {
+        in.targetComponent.push_back(map.getComponent(tile));
+    }
+    std::vector<size_t> sourceComponent;
+    sourceComponent.reserve(sourceTiles.size());
+    for (size_t tile : sourceTiles) {
+        sourceComponent.push_back(map.getComponent(tile));
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, sourceTiles.size()));
+
+    std::vector<size_t> visited(threads, 0);
+    auto worker = [&](unsigned thread) {
+        SearchBuffers& buffers = threadBuffers();
+        for (size_t s = thread; s < sourceTiles.size(); s += threads) {
+            visited[thread] += searchFrom(in, buffers, sourceTiles[s], sourceComponent[s],
+                result.distances.data() + s * result.targets);
+        }
+    };
+
+    if (threads > 1) {
+        searchPool().run(threads, worker);
+    }
+    else if (threads == 1) {
+        worker(0);
+    }
+
+    for (size_t count : visited) {
+        result.visitedTiles += count;
+    }
+    return result;
+}
+
+size_t DistanceMatrix::nearestTarget(size_t source) const {
+    const uint32_t* distancesFrom = row(source);
+    size_t best = npos;
+    for (size_t t = 0; t < targets; ++t) {
+        if (distancesFrom[t] != UNREACHABLE && (best == npos || distancesFrom[t] < distancesFrom[best])) {
+            best = t;
+        }
+    }
+    return best;
+}
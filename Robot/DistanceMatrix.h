@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+// Gęsta macierz odległości (w krokach) od każdego źródła do każdego celu.
+// Wiersz i to źródło i, kolumna j to cel j w kolejności podanej przy liczeniu.
+class DistanceMatrix {
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+    static constexpr size_t npos = SIZE_MAX;
+
+private:
+    size_t sources = 0;
+    size_t targets = 0;
+    std::vector<uint32_t> distances;
+    size_t visitedTiles = 0;
+
+public:
+    DistanceMatrix() = default;
+
+    // One breadth-first search per source over walkable tiles; a search stops as soon as every
+    // target in the source's component is labelled. Sources are split between threads (0 = hardware)
+    // of one pool shared by all calls.
+    static DistanceMatrix compute(const Map& map, const std::vector<size_t>& sourceTiles,
+        const std::vector<size_t>& targetTiles, unsigned threads = 1);
+
+    size_t sourceCount() const noexcept { return sources; }
+    size_t targetCount() const noexcept { return targets; }
+    uint32_t at(size_t source, size_t target) const { return distances[source * targets + target]; }
+    const uint32_t* row(size_t source) const { return distances.data() + source * targets; }
+    // Target closest to the source, npos if none is reachable
+    size_t nearestTarget(size_t source) const;
+    // Tiles taken from the queue by all searches together
+    size_t getVisitedTiles() const noexcept { return visitedTiles; }
+};
@@ -0,0 +1,274 @@
+#include "Fleet.h"
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+void FleetMetrics::add() {
+    moves.push_back(0);
+    cleans.push_back(0);
+    waits.push_back(0);
+    sidesteps.push_back(0);
+    idleTicks.push_back(0);
+    dirtCleaned.push_back(0);
+}
+
+Fleet::Fleet(Map& worldMap) : Fleet(worldMap, Options{}) {}
+
+Fleet::Fleet(Map& worldMap, Options fleetOptions)
+    : world(worldMap), options(fleetOptions), occupant(worldMap.getSize(), NO_ROBOT), claims(worldMap.getSize()) {}
+
+size_t Fleet::addRobot(Robot robot) {
+    const Map& memory = robot.getMemoryMap();
+    if (memory.getWidth() != world.getWidth() || memory.getHeight() != world.getHeight()) {
+        throw std::runtime_error("Robot memory map has different dimensions than the world.");
+    }
+    const size_t position = robot.getPosition();
+    if (!world.canMoveOn(position)) {
+        throw std::runtime_error("Robot position " + std::to_string(position) + " is not walkable.");
+    }
+    if (!isFree(position)) {
+        throw std::runtime_error("Tile " + std::to_string(position) + " is already taken by another robot.");
+    }
+
+    const uint32_t index = static_cast<uint32_t>(robots.size());
+    robots.push_back(std::move(robot));
+    robots.back().setClaimedTiles(&claims);
+    claimOf.push_back(TileBitset::npos);
+    positions.push_back(position);
+    active.push_back(1);
+    errors.push_back(RobotError::none);
+    errorTiles.push_back(0);
+    waitStreak.push_back(0);
+    pushed.push_back(0);
+    metrics.add();
+    occupy(position, index);
+    activeCount++;
+    return index;
+}
+
+size_t Fleet::addRobot(size_t position) {
+    Robot robot(world.getWidth(), world.getHeight(), world.getChargerId());
+    robot.setPosition(position);
+    return addRobot(std::move(robot));
+}
+
+void Fleet::occupy(size_t tile, uint32_t index) {
+    if (tile != world.getChargerId()) {
+        occupant[tile] = index;
+    }
+}
+
+void Fleet::release(size_t tile) {
+    if (tile != world.getChargerId()) {
+        occupant[tile] = NO_ROBOT;
+    }
+}
+
+void Fleet::activate(size_t index) {
+    if (!active.at(index)) {
+        active[index] = 1;
+        errors[index] = RobotError::none;
+        activeCount++;
+    }
+}
+
+void Fleet::releaseClaim(size_t index) {
+    if (claimOf[index] != TileBitset::npos) {
+        claims.reset(claimOf[index]);
+        claimOf[index] = TileBitset::npos;
+    }
+}
+
+void Fleet::updateClaim(size_t index, RobotAction action) {
+    Robot& robot = robots[index];
+    size_t target = TileBitset::npos;
+    if (action == RobotAction::clean) {
+        target = positions[index];
+    }
+    else if (!robot.getPath().empty()) {
+        const Floor* floor = robot.getMemoryMap().getTile(robot.getPath().back())->asFloor();
+        if (floor && floor->isDirty()) {
+            target = robot.getPath().back();
+        }
+    }
+    if (target == TileBitset::npos) {
+        return;
+    }
+    if (claims.test(target)) {
+        // Trasa zaplanowana zanim inny robot wybrał ten kafelek - następny krok wybierze inny cel
+        robot.dropPath();
+        return;
+    }
+    claims.set(target);
+    claimOf[index] = target;
+}
+
+void Fleet::sense(size_t index) {
+    const size_t position = positions[index];
+    const size_t tiles[5] = { position,
+        world.getIndex(position, Direction::up).value_or(position),
+        world.getIndex(position, Direction::down).value_or(position),
+        world.getIndex(position, Direction::left).value_or(position),
+        world.getIndex(position, Direction::right).value_or(position) };
+
+    for (size_t tile : tiles) {
+        const Tile* tileObj = world.getTile(tile);
+        // Rozsyłane są tylko nowe informacje - znane kafelki nic nie kosztują pozostałych robotów
+        if (robots[index].exploreTile(tile, tileObj) && options.shareDiscovery) {
+            for (size_t other = 0; other < robots.size(); ++other) {
+                if (other != index) {
+                    robots[other].exploreTile(tile, tileObj);
+                }
+            }
+        }
+    }
+}
+
+bool Fleet::makeWay(size_t index, size_t blocked, size_t requester, int depth) {
+    const size_t position = positions[index];
+    const Map& memory = robots[index].getMemoryMap();
+    std::optional<size_t> neighbours[4];
+    size_t count = 0;
+    for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+        auto neighbour = world.getIndex(position, dir);
+        if (neighbour.has_value() && *neighbour != blocked && world.canMoveOn(*neighbour) && memory.canMoveOn(*neighbour)) {
+            neighbours[count++] = neighbour;
+        }
+    }
+
+    // Najpierw wolny sąsiad, potem przepchnięcie robota o niższym priorytecie niż proszący
+    bool moved = false;
+    for (size_t i = 0; i < count && !moved; ++i) {
+        moved = isFree(*neighbours[i]) && robots[index].sidestep(*neighbours[i]);
+    }
+    for (size_t i = 0; i < count && !moved && depth > 0; ++i) {
+        const uint32_t other = occupant[*neighbours[i]];
+        moved = other != NO_ROBOT && other > requester && other != index && active[other]
+            && makeWay(other, position, requester, depth - 1) && robots[index].sidestep(*neighbours[i]);
+    }
+    if (!moved) {
+        return false;
+    }
+
+    release(position);
+    occupy(robots[index].getPosition(), static_cast<uint32_t>(index));
+    positions[index] = robots[index].getPosition();
+    metrics.sidesteps[index]++;
+    if (index != requester) {
+        pushed[index] = 1;
+    }
+    return true;
+}
+
+void Fleet::stepRobot(size_t index) {
+    Robot& robot = robots[index];
+    // Pozycja zmieniona z zewnątrz, np. przez setPosition
+    if (robot.getPosition() != positions[index]) {
+        release(positions[index]);
+        positions[index] = robot.getPosition();
+        occupy(positions[index], static_cast<uint32_t>(index));
+    }
+
+    sense(index);
+    const size_t from = positions[index];
+    releaseClaim(index);
+    const RobotStep step = robot.step();
+
+    if (step.error != RobotError::none) {
+        // Robot stays where it stopped and keeps its tile
+        active[index] = 0;
+        errors[index] = step.error;
+        errorTiles[index] = step.errorTile;
+        activeCount--;
+        return;
+    }
+
+    switch (step.action) {
+    case RobotAction::move: {
+        const size_t to = robot.getPosition();
+        if (to == from) {
+            metrics.idleTicks[index]++;
+            break;
+        }
+        if (isFree(to)) {
+            release(from);
+            occupy(to, static_cast<uint32_t>(index));
+            positions[index] = to;
+            metrics.moves[index]++;
+            waitStreak[index] = 0;
+            break;
+        }
+
+        // Robot z niższym priorytetem (dalszy indeks) musi od razu zrobić miejsce
+        const uint32_t blocker = occupant[to];
+        if (blocker > index && active[blocker] && makeWay(blocker, from, index, PUSH_DEPTH)) {
+            release(from);
+            occupy(to, static_cast<uint32_t>(index));
+            positions[index] = to;
+            metrics.moves[index]++;
+            waitStreak[index] = 0;
+            break;
+        }
+
+        // Inaczej czekanie, a po kilku taktach ustąpienie robotowi z wyższym priorytetem
+        robot.cancelMove(from);
+        metrics.waits[index]++;
+        if (++waitStreak[index] >= options.yieldAfter) {
+            // Roboty przed nim widzą cel - stan celu z tłumu jest już pewnie nieaktualny
+            const size_t target = robot.getPath().back();
+            if (robot.exploreTile(target, world.getTile(target))) {
+                robot.dropPath();
+            }
+            else if ((blocker < index || !active[blocker]) && makeWay(index, to, index, PUSH_DEPTH)) {
+                waitStreak[index] = 0;
+            }
+        }
+        break;
+    }
+    case RobotAction::clean: {
+        if (Floor* floor = world.editFloor(from)) {
+            const unsigned int before = floor->getCleanliness();
+            floor->getCleaned(robot.getCleaningEfficiency());
+            metrics.dirtCleaned[index] += before - floor->getCleanliness();
+        }
+        metrics.cleans[index]++;
+        waitStreak[index] = 0;
+        break;
+    }
+    case RobotAction::none:
+        // All known work done, robot rests at the charger
+        active[index] = 0;
+        activeCount--;
+        break;
+    default:
+        metrics.idleTicks[index]++;
+        break;
+    }
+    if (active[index]) {
+        updateClaim(index, step.action);
+    }
+}
+
+size_t Fleet::tick() {
+    for (size_t i = 0; i < robots.size(); ++i) {
+        if (pushed[i]) {
+            // Ustąpienie miejsca było już ruchem w tym takcie
+            pushed[i] = 0;
+        }
+        else if (active[i]) {
+            stepRobot(i);
+        }
+    }
+    ticks++;
+    return activeCount;
+}
+
+size_t Fleet::run(size_t maxTicks) {
+    size_t made = 0;
+    while (made < maxTicks && activeCount > 0) {
+        tick();
+        made++;
+    }
+    return made;
+}
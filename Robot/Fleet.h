@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Map.h"
+#include "Robot.h"
+#include "TileBitset.h"
+
+// Liczniki robotów floty trzymane kolumnami: element i każdej tablicy dotyczy robota i
+struct FleetMetrics {
+    std::vector<uint32_t> moves;
+    std::vector<uint32_t> cleans;
+    std::vector<uint32_t> waits;        // Ticks spent behind another robot
+    std::vector<uint32_t> sidesteps;
+    std::vector<uint32_t> idleTicks;
+    std::vector<uint64_t> dirtCleaned;
+
+    void add();
+    size_t size() const noexcept { return moves.size(); }
+};
+
+// Flota robotów na jednej mapie świata. Każdy takt roboty po kolei odczytują
+// swój kafelek i sąsiadów, wykonują krok i zmieniają świat (sprzątanie).
+// Kafelek może zajmować tylko jeden robot, poza ładowarką. Priorytet ma robot
+// o mniejszym indeksie: robot o niższym priorytecie od razu schodzi mu z drogi.
+// Brudny kafelek wybrany przez jednego robota jest pomijany przez pozostałe.
+class Fleet {
+public:
+    struct Options {
+        bool shareDiscovery = false; // Tiles that change a robot's memory are sent to all robots
+        uint32_t yieldAfter = 2;     // Waiting ticks before a robot makes way for a robot with higher priority
+    };
+
+private:
+    static constexpr uint32_t NO_ROBOT = UINT32_MAX;
+    static constexpr int PUSH_DEPTH = 3;    // Robots pushed in a row to clear the way
+
+    Map& world;
+    Options options;
+    std::vector<Robot> robots;
+
+    // Stan robotów w tablicach, żeby takt przechodził po ciągłej pamięci
+    std::vector<size_t> positions;
+    std::vector<uint8_t> active;
+    std::vector<RobotError> errors;
+    std::vector<size_t> errorTiles;
+    std::vector<uint32_t> waitStreak;
+    std::vector<uint8_t> pushed;    // Made way for another robot earlier in this tick
+    FleetMetrics metrics;
+
+    std::vector<uint32_t> occupant; // Robot on each world tile; the charger is never occupied
+    // Brudne kafelki, do których jedzie albo które sprząta któryś robot - inne ich nie wybierają
+    TileBitset claims;
+    std::vector<size_t> claimOf;
+    size_t ticks = 0;
+    size_t activeCount = 0;
+
+    void sense(size_t index);
+    void occupy(size_t tile, uint32_t index);
+    void release(size_t tile);
+    bool isFree(size_t tile) const { return tile == world.getChargerId() || occupant[tile] == NO_ROBOT; }
+    void stepRobot(size_t index);
+    // Moves robot index off its tile, not onto blocked; may push robots with lower priority than requester
+    bool makeWay(size_t index, size_t blocked, size_t requester, int depth);
+    void updateClaim(size_t index, RobotAction action);
+    void releaseClaim(size_t index);
+
+public:
+    explicit Fleet(Map& worldMap);
+    Fleet(Map& worldMap, Options fleetOptions);
+    // Robots point at the fleet's claims
+    Fleet(const Fleet&) = delete;
+    Fleet& operator=(const Fleet&) = delete;
+
+    // Robot memory must have the world's dimensions and stand on a free walkable tile; returns its index
+    size_t addRobot(Robot robot);
+    // Robot without memory of the map at the given tile
+    size_t addRobot(size_t position);
+
+    // Steps every active robot once; returns the number of robots still active
+    size_t tick();
+    // Ticks until no robot is active or maxTicks is reached; returns the ticks made
+    size_t run(size_t maxTicks);
+
+    size_t size() const noexcept { return robots.size(); }
+    size_t getTicks() const noexcept { return ticks; }
+    size_t getActiveCount() const noexcept { return activeCount; }
+    const Robot& getRobot(size_t index) const { return robots.at(index); }
+    Robot& getRobot(size_t index) { return robots.at(index); }
+    size_t getPosition(size_t index) const { return positions.at(index); }
+    bool isActive(size_t index) const { return active.at(index) != 0; }
+    // Error that stopped the robot, RobotError::none while it runs or after it finished
+    RobotError getError(size_t index) const { return errors.at(index); }
+    size_t getErrorTile(size_t index) const { return errorTiles.at(index); }
+    // Makes a finished robot take part in ticks again, e.g. after a new order
+    void activate(size_t index);
+    const FleetMetrics& getMetrics() const noexcept { return metrics; }
+    const Options& getOptions() const noexcept { return options; }
+};
@@ -1,7 +1,7 @@
 #include "Floor.h"
 #include <algorithm>
 
-Floor::Floor(size_t id, unsigned int cleanliness) : Tile(id) {
+Floor::Floor(unsigned int cleanliness) : Tile(TileKind::floor) {
     this->cleanliness = std::min(cleanliness, 9u); // poziom brudu między 0 a 9
 }
 
@@ -6,7 +6,7 @@ private:
     unsigned int cleanliness; // Wartość między 0-9; 0 oznacza czystą podłogę
 
 public:
-    Floor(size_t id = 0, unsigned int cleanliness = 0);
+    explicit Floor(unsigned int cleanliness = 0);
 
     // Virtual copy constructor
     std::unique_ptr<Tile> clone() const override;
@@ -0,0 +1,38 @@
+#include "FrontierFirstStrategy.h"
+
+bool FrontierFirstStrategy::createPathFrontier(Robot& robot) {
+    const Map& map = memory(robot);
+    SearchTree& tree = threadSearchTree();
+    size_t frontier = NO_PARENT;
+
+    searchFrom(robot, tree, [&](size_t tile, size_t distance) {
+        if (distance == 0) {
+            return false;
+        }
+        for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+            auto neighbour = map.getIndex(tile, dir);
+            if (neighbour.has_value() && map.getTile(*neighbour)->getKind() == TileKind::unvisited) {
+                frontier = tile;
+                return true;
+            }
+        }
+        return false;
+    });
+
+    if (frontier == NO_PARENT) {
+        return false;
+    }
+    setPath(robot, tree, frontier);
+    return true;
+}
+
+std::optional<RobotAction> FrontierFirstStrategy::plan(Robot& robot) const {
+    if (createPathDirtyNeighbour(robot) || hasPath(robot) || createPathFrontier(robot)
+        || createPathTrash(robot) || createPathToVisit(robot) || createPathToCharger(robot)) {
+        return RobotAction::clean;
+    }
+    if (createPathUnvisited(robot)) {
+        return RobotAction::explore;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "CleaningStrategy.h"
+
+// Najpierw odkrywa mapę: jedzie do najbliższego znanego kafelka sąsiadującego z nieodwiedzonym
+class FrontierFirstStrategy : public CleaningStrategy {
+private:
+    static bool createPathFrontier(Robot& robot);
+
+public:
+    const char* getName() const noexcept override { return "frontier-first"; }
+    std::optional<RobotAction> plan(Robot& robot) const override;
+};
@@ -0,0 +1,19 @@
+#include "GreedyStrategy.h"
+
+const GreedyStrategy::Rule GreedyStrategy::RULES[] = {
+    { &CleaningStrategy::createPathDirtyNeighbour, RobotAction::clean },
+    { &CleaningStrategy::hasPath, RobotAction::clean },
+    { &CleaningStrategy::createPathTrash, RobotAction::clean },
+    { &CleaningStrategy::createPathToVisit, RobotAction::clean },
+    { &CleaningStrategy::createPathToCharger, RobotAction::clean },
+    { &CleaningStrategy::createPathUnvisited, RobotAction::explore },
+};
+
+std::optional<RobotAction> GreedyStrategy::plan(Robot& robot) const {
+    for (const Rule& rule : RULES) {
+        if (rule.plan(robot)) {
+            return rule.nextTask;
+        }
+    }
+    return std::nullopt;
+}
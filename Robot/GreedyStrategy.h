@@ -0,0 +1,17 @@
+#pragma once
+#include "CleaningStrategy.h"
+
+// Domyślna strategia: najbliższy brud, potem kafelki do sprawdzenia, potem ładowarka
+class GreedyStrategy : public CleaningStrategy {
+private:
+    // Planner and the task set when it finds a path; tried in order
+    struct Rule {
+        bool (*plan)(Robot& robot);
+        RobotAction nextTask;
+    };
+    static const Rule RULES[];
+
+public:
+    const char* getName() const noexcept override { return "greedy"; }
+    std::optional<RobotAction> plan(Robot& robot) const override;
+};
@@ -0,0 +1,223 @@
+#include "LandmarkTable.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Map.h"
+#include "StaticMap.h"
+
+namespace {
+    constexpr uint32_t UNREACHED = UINT32_MAX;
+    const char* const HEADER = "ALT 1";
+
+    // Odległości od source do wszystkich kafelków po przejezdnych kafelkach
+    void distancesFrom(const Map& map, const std::vector<uint64_t>& walkable, size_t source,
+        std::vector<uint32_t>& dist, std::vector<TileIndex>& queue) {
+        const size_t width = map.getWidth();
+        const size_t size = map.getSize();
+        std::fill(dist.begin(), dist.end(), UNREACHED);
+        queue.clear();
+        queue.push_back(static_cast<TileIndex>(source));
+        dist[source] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const size_t tile = queue[head];
+            const size_t x = tile % width;
+            const size_t neighbours[4] = { tile >= width ? tile - width : tile,
+                tile + width < size ? tile + width : tile,
+                x > 0 ? tile - 1 : tile,
+                x + 1 < width ? tile + 1 : tile };
+            for (size_t neighbour : neighbours) {
+                if (dist[neighbour] == UNREACHED && ((walkable[neighbour / 64] >> (neighbour % 64)) & 1u)) {
+                    dist[neighbour] = dist[tile] + 1;
+                    queue.push_back(static_cast<TileIndex>(neighbour));
+                }
+            }
+        }
+    }
+
+    // Wartości zapisywane little-endian niezależnie od platformy, w kawałkach przez bufor
+    constexpr size_t CHUNK_VALUES = 4096;
+
+    template <typename T>
+    void writeValues(std::ostream& out, const std::vector<T>& values) {
+        std::vector<char> buffer(CHUNK_VALUES * sizeof(T));
+        for (size_t first = 0; first < values.size(); first += CHUNK_VALUES) {
+            const size_t chunk = std::min(CHUNK_VALUES, values.size() - first);
+            for (size_t i = 0; i < chunk; ++i) {
+                for (size_t byte = 0; byte < sizeof(T); ++byte) {
+                    buffer[i * sizeof(T) + byte] = static_cast<char>((values[first + i] >> (8 * byte)) & 0xFF);
+                }
+            }
+            out.write(buffer.data(), static_cast<std::streamsize>(chunk * sizeof(T)));
+        }
+    }
+
+    template <typename T>
+    void readValues(std::istream& in, std::vector<T>& values) {
+        std::vector<unsigned char> buffer(CHUNK_VALUES * sizeof(T));
+        for (size_t first = 0; first < values.size(); first += CHUNK_VALUES) {
+            const size_t chunk = std::min(CHUNK_VALUES, values.size() - first);
+            if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(chunk * sizeof(T)))) {
+                throw std::runtime_error("Landmark table is truncated.");
+            }
+            for (size_t i = 0; i < chunk; ++i) {
+                T value = 0;
+                for (size_t byte = 0; byte < sizeof(T); ++byte) {
+                    value |= static_cast<T>(static_cast<T>(buffer[i * sizeof(T) + byte]) << (8 * byte));
+                }
+                values[first + i] = value;
+            }
+        }
+    }
+}
+
+LandmarkTable LandmarkTable::build(const Map& map, size_t count) {
+    LandmarkTable table;
+    table.width = map.getWidth();
+    table.height = map.getHeight();
+    const size_t size = map.getSize();
+    table.walkable.assign((size + 63) / 64, 0);
+    size_t start = Map::NO_COMPONENT;
+    for (size_t tile = 0; tile < size; ++tile) {
+        if (map.canMoveOn(tile)) {
+            table.walkable[tile / 64] |= uint64_t{ 1 } << (tile % 64);
+            if (start == Map::NO_COMPONENT || tile == map.getChargerId()) {
+                start = tile;
+            }
+        }
+    }
+    if (start == Map::NO_COMPONENT || count == 0) {
+        return table;
+    }
+
+    // Pełne przeszukiwanie od każdego landmarku. Zarejestrowany plan piętra idzie po StaticMap,
+    // inna mapa po bitmapie przejezdności tabeli, 8 razy mniejszej niż siatka mapy.
+    std::vector<uint32_t> dist(size);
+    std::vector<TileIndex> queue;
+    queue.reserve(size);
+    table.distances.assign(size * count, UNKNOWN);
+    visitGrid(map, [&](const auto& grid) {
+        auto distances = [&](size_t source) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(grid)>, Map>) {
+                distancesFrom(map, table.walkable, source, dist, queue);
+            }
+            else {
+                breadthFirstDistances(grid, source, dist, queue);
+            }
+        };
+        distances(start);
+        // Najbliższy z wybranych landmarków; kafelki innych składowych pozostają UNREACHED
+        std::vector<uint32_t> nearest(size, UNREACHED);
+        size_t next = static_cast<size_t>(std::max_element(dist.begin(), dist.end(),
+            [](uint32_t a, uint32_t b) { return (a == UNREACHED ? 0 : a) < (b == UNREACHED ? 0 : b); }) - dist.begin());
+
+        while (table.landmarks.size() < count) {
+            const size_t k = table.landmarks.size();
+            table.landmarks.push_back(next);
+            distances(next);
+
+            uint32_t farthest = 0;
+            for (size_t tile = 0; tile < size; ++tile) {
+                if (dist[tile] == UNREACHED) {
+                    continue;
+                }
+                table.distances[tile * count + k] = dist[tile] < UNKNOWN ? static_cast<uint16_t>(dist[tile]) : UNKNOWN;
+                nearest[tile] = std::min(nearest[tile], dist[tile]);
+                if (nearest[tile] > farthest) {
+                    farthest = nearest[tile];
+                    next = tile;
+                }
+            }
+            if (farthest == 0) {
+                break;  // Every tile of the component is already a landmark
+            }
+        }
+    });
+
+    // Mniej landmarków niż żądano - kolumny przesuwane w miejscu
+    const size_t picked = table.landmarks.size();
+    if (picked < count) {
+        for (size_t tile = 0; tile < size; ++tile) {
+            std::copy_n(table.distances.begin() + tile * count, picked, table.distances.begin() + tile * picked);
+        }
+        table.distances.resize(size * picked);
+    }
+    return table;
+}
+
+std::filesystem::path LandmarkTable::sidecarPath(const std::filesystem::path& mapPath) {
+    std::filesystem::path path = mapPath;
+    path += ".alt";
+    return path;
+}
+
+void LandmarkTable::load(std::istream& in) {
+    std::string header;
+    std::getline(in, header);
+    if (header != HEADER) {
+        throw std::runtime_error("Not a landmark table.");
+    }
+    size_t newWidth = 0, newHeight = 0, count = 0;
+    if (!(in >> newWidth >> newHeight >> count)) {
+        throw std::runtime_error("Invalid landmark table dimensions.");
+    }
+    const size_t size = newWidth * newHeight;
+    if ((newHeight != 0 && size / newHeight != newWidth) || count > size) {
+        throw std::runtime_error("Invalid landmark table dimensions.");
+    }
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::vector<size_t> newLandmarks(count);
+    for (size_t& landmark : newLandmarks) {
+        if (!(in >> landmark) || landmark >= size) {
+            throw std::runtime_error("Invalid landmark tile.");
+        }
+    }
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');    // Binary part starts on the next line
+
+    std::vector<uint64_t> newWalkable((size + 63) / 64);
+    readValues(in, newWalkable);
+    std::vector<uint16_t> newDistances(size * count);
+    readValues(in, newDistances);
+
+    width = newWidth;
+    height = newHeight;
+    landmarks = std::move(newLandmarks);
+    walkable = std::move(newWalkable);
+    distances = std::move(newDistances);
+}
+
+void LandmarkTable::save(std::ostream& out) const {
+    out << HEADER << "\n" << width << " " << height << " " << landmarks.size() << "\n";
+    for (size_t i = 0; i < landmarks.size(); ++i) {
+        out << (i ? " " : "") << landmarks[i];
+    }
+    out << "\n";
+    writeValues(out, walkable);
+    writeValues(out, distances);
+}
+
+bool LandmarkTable::fits(const Map& map) const {
+    if (map.getWidth() != width || map.getHeight() != height) {
+        return false;
+    }
+    for (size_t tile = 0; tile < map.getSize(); ++tile) {
+        if (!wasWalkable(tile) && map.canMoveOn(tile)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t LandmarkTable::lowerBound(size_t from, size_t to) const noexcept {
+    const size_t count = landmarks.size();
+    const uint16_t* a = distances.data() + from * count;
+    const uint16_t* b = distances.data() + to * count;
+    size_t bound = 0;
+    for (size_t k = 0; k < count; ++k) {
+        if (a[k] != UNKNOWN && b[k] != UNKNOWN) {
+            bound = std::max<size_t>(bound, a[k] > b[k] ? a[k] - b[k] : b[k] - a[k]);
+        }
+    }
+    return bound;
+}
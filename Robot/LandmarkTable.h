@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+class Map;
+
+// Odległości od kilku kafelków-punktów orientacyjnych (landmarków) do każdego kafelka mapy.
+// Z nierówności trójkąta |d(L, a) - d(L, b)| <= d(a, b), więc tablica daje dolne
+// ograniczenie długości trasy dla A*. Ograniczenie zostaje poprawne, gdy na mapie
+// przybywa przeszkód; kafelek przejezdny, który przy liczeniu był zablokowany, unieważnia tablicę.
+class LandmarkTable {
+public:
+    static constexpr uint16_t UNKNOWN = UINT16_MAX; // Not reachable from the landmark or too far for 16 bits
+    static constexpr size_t DEFAULT_COUNT = 8;
+
+private:
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<size_t> landmarks;
+    std::vector<uint16_t> distances;    // Kafelkami: landmarks.size() odległości na kafelek
+    std::vector<uint64_t> walkable;     // Tiles walkable when the table was built, 64 per word
+
+public:
+    LandmarkTable() = default;
+
+    // Picks up to count landmarks, each the walkable tile farthest from the ones already picked,
+    // starting from the tile farthest from the charger
+    static LandmarkTable build(const Map& map, size_t count = DEFAULT_COUNT);
+    static std::filesystem::path sidecarPath(const std::filesystem::path& mapPath);
+
+    // Binary format; load throws std::runtime_error on a damaged stream
+    void load(std::istream& in);
+    void save(std::ostream& out) const;
+
+    bool empty() const noexcept { return landmarks.empty(); }
+    size_t getWidth() const noexcept { return width; }
+    size_t getHeight() const noexcept { return height; }
+    const std::vector<size_t>& getLandmarks() const noexcept { return landmarks; }
+    uint16_t distance(size_t landmark, size_t tile) const { return distances[tile * landmarks.size() + landmark]; }
+    bool wasWalkable(size_t tile) const noexcept { return (walkable[tile / 64] >> (tile % 64)) & 1u; }
+
+    // Same dimensions and no walkable tile of the map was blocked when the table was built
+    bool fits(const Map& map) const;
+    // Lower bound of the number of steps between two tiles, 0 when no landmark knows both
+    size_t lowerBound(size_t from, size_t to) const noexcept;
+};
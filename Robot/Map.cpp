@@ -1,7 +1,30 @@
 #include "Map.h"
+#include "MapCodec.h"
 #include <stdexcept>
 #include <string>
 #include <sstream>
+#include <cctype>
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // Wspólny kafelek wszystkich kawałków, które nie zostały jeszcze zapisane
+    const UnVisited& unvisitedTile() {
+        static const UnVisited tile;
+        return tile;
+    }
+
+    template <typename T, typename... Args>
+    Tile* constructTile(std::pmr::memory_resource& resource, Args... args) {
+        return ::new (resource.allocate(sizeof(T), alignof(T))) T(args...);
+    }
+
+    template <typename T>
+    void destroyTileAs(Tile* tile, std::pmr::memory_resource& resource) noexcept {
+        static_cast<T*>(tile)->~T();
+        resource.deallocate(tile, sizeof(T), alignof(T));
+    }
+}
 
 Map::Map(std::istream& in) {
     loadMap(in, false);
@@ -12,41 +35,379 @@ Map::Map(std::istream& in, bool allowUnvisited) {
 }
 
 Map::Map(size_t mapWidth, size_t mapHeight, size_t chargerTileId)
-    : width(mapWidth), height(mapHeight), chargerId(chargerTileId) {
-    tiles.reserve(width * height);
-    for (size_t i = 0; i < width * height; ++i) {
-        if (i == chargerTileId) {
-            tiles.push_back(std::make_unique<Charger>(i));
-        } else {
-            tiles.push_back(std::make_unique<UnVisited>(i));
-        }
+    : height(mapHeight), chargerId(chargerTileId) {
+    checkTileCount(mapWidth, mapHeight);
+    // Same nieodwiedzone kafelki - tworzony jest tylko kawałek z ładowarką
+    startChunks(mapWidth);
+    tileCount = width * height;
+    growChunks((height + CHUNK_SIDE - 1) / CHUNK_SIDE * chunkColumns);
+    if (chargerId < tileCount) {
+        materialize(chunkOf(chargerId), SIZE_MAX);
+        const uint8_t code = MapCodec::CHARGER;
+        placeTiles(chargerId, &code, 1, false);
     }
 }
 
-// Copy constructor
-Map::Map(const Map& other)
-    : width(other.width), height(other.height), chargerId(other.chargerId) {
-    tiles.reserve(other.tiles.size());
-    for (const auto& tile : other.tiles) {
-        tiles.push_back(tile->clone());
+Map::Map(std::pmr::memory_resource* tileResource) : tileResource(tileResource) {}
+
+Map::Map(std::shared_ptr<const Map> baseMap) {
+    if (!baseMap) {
+        throw std::runtime_error("Overlay needs a base map.");
     }
+    // Składowe bazy są liczone tutaj, bo później jest ona tylko czytana
+    baseMap->prepareComponents();
+    width = baseMap->width;
+    height = baseMap->height;
+    tileCount = baseMap->tileCount;
+    chunkColumns = baseMap->chunkColumns;
+    chargerId = baseMap->chargerId;
+    chunks.resize(baseMap->chunks.size());
+    grids = baseMap->grids;
+    base = std::move(baseMap);
+}
+
+std::shared_ptr<const Map> Map::share(Map map) {
+    map.prepareComponents();
+    map.tileChangeListener = nullptr;
+    return std::make_shared<const Map>(std::move(map));
+}
+
+// Copy constructor - a copied overlay shares the base
+Map::Map(const Map& other)
+    : width(other.width), height(other.height), tileCount(other.tileCount), chunkColumns(other.chunkColumns),
+      chargerId(other.chargerId), base(other.base) {
+    copyTiles(other);
 }
 
 // Copy assignment operator
 Map& Map::operator=(const Map& other) {
     if (this != &other) {
+        clearTiles();
         width = other.width;
         height = other.height;
+        tileCount = other.tileCount;
+        chunkColumns = other.chunkColumns;
         chargerId = other.chargerId;
-        tiles.clear();
-        tiles.reserve(other.tiles.size());
-        for (const auto& tile : other.tiles) {
-            tiles.push_back(tile->clone());
-        }
+        base = other.base;
+        copyTiles(other);
+        componentsDirty = true;
+        dropUndoLog();
+    }
+    return *this;
+}
+
+// Przeniesiona mapa zostaje pusta
+Map::Map(Map&& other) noexcept
+    : width(std::exchange(other.width, 0)), height(std::exchange(other.height, 0)),
+      tileCount(std::exchange(other.tileCount, 0)), chunkColumns(std::exchange(other.chunkColumns, 0)),
+      chunks(std::move(other.chunks)), pendingCodes(std::move(other.pendingCodes)),
+      gridCells(std::move(other.gridCells)), grids(std::move(other.grids)), chargerId(other.chargerId),
+      base(std::move(other.base)), tileChangeListener(std::move(other.tileChangeListener)), componentsDirty(other.componentsDirty),
+      undoLog(std::move(other.undoLog)), recordingUndo(std::exchange(other.recordingUndo, false)),
+      tileResource(std::exchange(other.tileResource, nullptr)), ownPool(std::move(other.ownPool)) {
+    other.chunks.clear();
+    other.gridCells.clear();
+    other.grids.clear();
+    other.undoLog.clear();
+}
+
+Map& Map::operator=(Map&& other) noexcept {
+    if (this != &other) {
+        clearTiles();
+        width = std::exchange(other.width, 0);
+        height = std::exchange(other.height, 0);
+        tileCount = std::exchange(other.tileCount, 0);
+        chunkColumns = std::exchange(other.chunkColumns, 0);
+        chunks = std::move(other.chunks);
+        other.chunks.clear();
+        pendingCodes = std::move(other.pendingCodes);
+        gridCells = std::move(other.gridCells);
+        other.gridCells.clear();
+        grids = std::move(other.grids);
+        other.grids.clear();
+        chargerId = other.chargerId;
+        base = std::move(other.base);
+        tileChangeListener = std::move(other.tileChangeListener);
+        componentsDirty = other.componentsDirty;
+        undoLog = std::move(other.undoLog);
+        other.undoLog.clear();
+        recordingUndo = std::exchange(other.recordingUndo, false);
+        // Kafelki zostają w zasobie, z którego je zaalokowano
+        tileResource = std::exchange(other.tileResource, nullptr);
+        ownPool = std::move(other.ownPool);
     }
     return *this;
 }
 
+Map::~Map() {
+    clearTiles();
+}
+
+void Map::clearTiles() {
+    if (ownPool && tileResource == ownPool.get()) {
+        // Własna pula jest zwalniana w całości; kafelki nie trzymają zasobów, więc bez destruktorów
+        chunks.clear();
+        ownPool->release();
+    }
+    // Kafelki z zasobu wywołującego są zwalniane w kolejności tworzenia (wierszami), co wyraźnie
+    // przyspiesza zarówno zwalnianie, jak i ponowne wczytanie mapy w to samo miejsce
+    else if (width != 0) {
+        const size_t rows = (tileCount + width - 1) / width;
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t cx = 0; cx < chunkColumns; ++cx) {
+                const size_t chunk = row / CHUNK_SIDE * chunkColumns + cx;
+                if (chunk < chunks.size() && chunks[chunk]) {
+                    for (size_t x = 0; x < CHUNK_SIDE; ++x) {
+                        Tile*& tile = chunks[chunk]->tiles[slotAt(x, row % CHUNK_SIDE)];
+                        if (tile) {
+                            destroyTile(tile);
+                            tile = nullptr;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    chunks.clear();
+    gridCells.clear();
+    grids.clear();
+}
+
+void Map::copyTiles(const Map& other) {
+    clearTiles();
+    chunks.resize(other.chunks.size());
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!other.chunks[c]) {
+            continue;
+        }
+        chunks[c] = std::make_unique<Chunk>();
+        for (size_t slot = 0; slot < CHUNK_TILES; ++slot) {
+            if (other.chunks[c]->tiles[slot]) {
+                chunks[c]->tiles[slot] = createTile(tileCode(other.chunks[c]->tiles[slot]));
+            }
+        }
+    }
+    pendingCodes = other.pendingCodes;
+    copyGrids(other);
+}
+
+void Map::copyGrids(const Map& other) {
+    grids = other.grids;
+    gridCells.clear();
+    if (base && base == other.base) {
+        return;
+    }
+    gridCells.reserve(GRID_CELLS * static_cast<size_t>(std::count_if(grids.begin(), grids.end(),
+        [](const uint8_t* grid) { return grid != EMPTY_GRID; })));
+    for (const uint8_t*& grid : grids) {
+        if (grid != EMPTY_GRID) {
+            gridCells.insert(gridCells.end(), grid, grid + GRID_CELLS);
+            grid = gridCells.data() + gridCells.size() - GRID_CELLS;
+        }
+    }
+}
+
+void Map::growChunks(size_t count) {
+    const size_t first = chunks.size();
+    chunks.resize(count);
+    grids.resize(count, EMPTY_GRID);
+    // Wiersz kafelków nad nowymi kawałkami mógł być zapisany, zanim powstały
+    for (size_t c = std::max(first, chunkColumns); c < count; ++c) {
+        // Siatka nad kawałkiem jest czytana przez tablicę, bo addGrid może przenieść bufor
+        for (size_t x = 1; x <= CHUNK_SIDE && grids[c - chunkColumns] != EMPTY_GRID; ++x) {
+            if (grids[c - chunkColumns][CHUNK_SIDE * GRID_SIDE + x]) {
+                setGridCell(c, x, true);
+            }
+        }
+    }
+}
+
+void Map::setGridCell(size_t chunk, size_t cell, bool walkable) {
+    // Kawałki pod ostatnim wczytanym wierszem dostaną ramkę w growChunks
+    if (chunk >= grids.size()) {
+        return;
+    }
+    if (grids[chunk] == EMPTY_GRID) {
+        if (!walkable) {
+            return;
+        }
+        addGrid(chunk);
+    }
+    gridCells[static_cast<size_t>(grids[chunk] - gridCells.data()) + cell] = walkable;
+}
+
+void Map::addGrid(size_t chunk) {
+    if (gridCells.size() + GRID_CELLS > gridCells.capacity()) {
+        // Nowy bufor - wskaźniki siatek są przenoszone, póki stary jeszcze istnieje
+        std::vector<uint8_t> larger;
+        larger.reserve(std::max(2 * gridCells.capacity(), 4 * GRID_CELLS));
+        larger.assign(gridCells.begin(), gridCells.end());
+        for (const uint8_t*& grid : grids) {
+            if (grid != EMPTY_GRID) {
+                grid = larger.data() + (grid - gridCells.data());
+            }
+        }
+        gridCells.swap(larger);
+    }
+    gridCells.resize(gridCells.size() + GRID_CELLS, 0);
+    grids[chunk] = gridCells.data() + gridCells.size() - GRID_CELLS;
+}
+
+void Map::setWalkable(size_t column, size_t row, bool walkable) {
+    const size_t chunk = row / CHUNK_SIDE * chunkColumns + column / CHUNK_SIDE;
+    const size_t x = column % CHUNK_SIDE + 1;
+    const size_t y = row % CHUNK_SIDE + 1;
+    setGridCell(chunk, y * GRID_SIDE + x, walkable);
+    // Skrajne kafelki kawałka są też w ramkach sąsiadów
+    if (x == 1 && column != 0) {
+        setGridCell(chunk - 1, y * GRID_SIDE + CHUNK_SIDE + 1, walkable);
+    }
+    if (x == CHUNK_SIDE && column + 1 < width) {
+        setGridCell(chunk + 1, y * GRID_SIDE, walkable);
+    }
+    if (y == 1 && row != 0) {
+        setGridCell(chunk - chunkColumns, (CHUNK_SIDE + 1) * GRID_SIDE + x, walkable);
+    }
+    if (y == CHUNK_SIDE) {
+        setGridCell(chunk + chunkColumns, x, walkable);
+    }
+}
+
+void Map::startChunks(size_t mapWidth) {
+    width = mapWidth;
+    chunkColumns = (width + CHUNK_SIDE - 1) / CHUNK_SIDE;
+    if (!pendingCodes.empty()) {
+        placeTiles(0, pendingCodes.data(), pendingCodes.size(), false);
+        pendingCodes.clear();
+    }
+}
+
+Map::Chunk& Map::materialize(size_t chunk, size_t filledBefore) {
+    const Chunk* shared = base ? base->findChunk(chunk) : nullptr;
+    chunks[chunk] = std::make_unique<Chunk>();
+    Chunk& created = *chunks[chunk];
+    if (!base && !componentsDirty) {
+        created.componentParent = std::make_unique<TileIndex[]>(CHUNK_TILES);
+        std::fill_n(created.componentParent.get(), CHUNK_TILES, NO_TILE);
+    }
+    forEachChunkTile(chunk, [&](size_t tileId, size_t slot) {
+        if (shared && shared->tiles[slot]) {
+            created.tiles[slot] = createTile(tileCode(shared->tiles[slot]));
+        }
+        else if (shared || tileId < filledBefore) {
+            created.tiles[slot] = createTile(MapCodec::UNVISITED);
+        }
+    });
+    return created;
+}
+
+void Map::detachBase() {
+    copyGrids(*base);
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c] && base->findChunk(c)) {
+            materialize(c, SIZE_MAX);
+        }
+    }
+    base.reset();
+    componentsDirty = true;
+}
+
+template <typename Fn>
+void Map::forEachChunkTile(size_t chunk, Fn&& fn) const {
+    const size_t firstRow = chunk / chunkColumns * CHUNK_SIDE;
+    const size_t firstColumn = chunk % chunkColumns * CHUNK_SIDE;
+    const size_t columns = std::min(CHUNK_SIDE, width - firstColumn);
+    // Podczas wczytywania wysokość rośnie - liczą się wiersze już rozpoczęte
+    const size_t rows = std::min(CHUNK_SIDE, (tileCount + width - 1) / width - firstRow);
+    for (size_t y = 0; y < rows; ++y) {
+        for (size_t x = 0; x < columns; ++x) {
+            fn((firstRow + y) * width + firstColumn + x, slotAt(x, y));
+        }
+    }
+}
+
+void Map::placeTiles(size_t firstId, const uint8_t* codes, size_t count, bool repeat) {
+    // Kolejne kafelki idą wierszami - pozycja jest przesuwana bez dzielenia dla każdego kafelka
+    size_t row = firstId / width;
+    size_t column = firstId - row * width;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t tileId = firstId + i;
+        const size_t chunk = row / CHUNK_SIDE * chunkColumns + column / CHUNK_SIDE;
+        if (chunk >= chunks.size()) {
+            growChunks((row / CHUNK_SIDE + 1) * chunkColumns);
+        }
+        const uint8_t code = repeat ? codes[0] : codes[i];
+        const size_t x = column % CHUNK_SIDE;
+        const size_t y = row % CHUNK_SIDE;
+        if (chunks[chunk] || code != MapCodec::UNVISITED) {
+            if (!chunks[chunk]) {
+                materialize(chunk, tileId);
+            }
+            Tile*& tile = chunks[chunk]->tiles[slotAt(x, y)];
+            if (tile) {
+                destroyTile(tile);
+            }
+            tile = createTile(code);
+        }
+        const bool walkable = code != MapCodec::OBSTACLE && code != MapCodec::UNVISITED;
+        // Kafelek wnętrza kawałka nie występuje w ramkach sąsiadów
+        if (x - 1 < CHUNK_SIDE - 2 && y - 1 < CHUNK_SIDE - 2 && grids[chunk] != EMPTY_GRID) {
+            gridCells[static_cast<size_t>(grids[chunk] - gridCells.data()) + (y + 1) * GRID_SIDE + x + 1] = walkable;
+        }
+        else {
+            setWalkable(column, row, walkable);
+        }
+        if (++column == width) {
+            column = 0;
+            row++;
+        }
+    }
+}
+
+std::pmr::memory_resource& Map::tileMemory() {
+    if (!tileResource) {
+        ownPool = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        tileResource = ownPool.get();
+    }
+    return *tileResource;
+}
+
+Tile* Map::createTile(uint8_t code) {
+    std::pmr::memory_resource& resource = tileMemory();
+    switch (code) {
+    case MapCodec::OBSTACLE:
+        return constructTile<Obstacle>(resource);
+    case MapCodec::CHARGER:
+        return constructTile<Charger>(resource);
+    case MapCodec::UNVISITED:
+        return constructTile<UnVisited>(resource);
+    default:
+        return constructTile<Floor>(resource, static_cast<unsigned int>(code));
+    }
+}
+
+void Map::destroyTile(Tile* tile) noexcept {
+    switch (tile->getKind()) {
+    case TileKind::floor:
+        destroyTileAs<Floor>(tile, *tileResource);
+        break;
+    case TileKind::obstacle:
+        destroyTileAs<Obstacle>(tile, *tileResource);
+        break;
+    case TileKind::charger:
+        destroyTileAs<Charger>(tile, *tileResource);
+        break;
+    default:
+        destroyTileAs<UnVisited>(tile, *tileResource);
+        break;
+    }
+}
+
+size_t Map::getLoadedChunkCount() const noexcept {
+    return static_cast<size_t>(std::count_if(chunks.begin(), chunks.end(),
+        [](const std::unique_ptr<Chunk>& chunk) { return chunk != nullptr; }));
+}
+
 size_t Map::getWidth() const noexcept {
     return width;
 }
@@ -64,18 +425,36 @@ bool Map::isMapValid() const {
 }
 
 bool Map::isMapValid(bool allowUnvisited) const {
-    if (tiles.size() != width * height) {
+    if (tileCount != width * height) {
         return false;
     }
 
     size_t chargerCount = 0;
-    for (const auto& tile : tiles) {
-        if (dynamic_cast<const Charger*>(tile.get())) {
-            chargerCount++;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        const Chunk* chunk = findChunk(c);
+        if (!chunk) {
+            // Sprawdź czy UnVisited są dozwolone
+            if (!allowUnvisited) {
+                return false;
+            }
+            continue;
         }
-
-        // Sprawdź czy UnVisited są dozwolone
-        if (!allowUnvisited && dynamic_cast<const UnVisited*>(tile.get())) {
+        bool valid = true;
+        forEachChunkTile(c, [&](size_t, size_t slot) {
+            const Tile* tile = chunk->tiles[slot];
+            if (!tile) {
+                valid = false;
+                return;
+            }
+            const TileKind kind = tile->getKind();
+            if (kind == TileKind::charger) {
+                chargerCount++;
+            }
+            if (!allowUnvisited && kind == TileKind::unvisited) {
+                valid = false;
+            }
+        });
+        if (!valid) {
             return false;
         }
     }
@@ -84,10 +463,7 @@ bool Map::isMapValid(bool allowUnvisited) const {
 }
 
 bool Map::canMoveOn(size_t tileId) const {
-    if (tileId >= tiles.size()) {
-        return false;
-    }
-    return tiles[tileId]->isMoveValid();
+    return tileId < tileCount && width != 0 && *cellOf(tileId);
 }
 
 void Map::loadMap(std::istream& in) {
@@ -95,54 +471,199 @@ void Map::loadMap(std::istream& in) {
 }
 
 void Map::loadMap(std::istream& in, bool allowUnvisited) {
-    tiles.clear();
+    parseRows(in, allowUnvisited, false);
+}
+
+void Map::loadMapSection(std::istream& in, bool allowUnvisited) {
+    parseRows(in, allowUnvisited, true);
+}
+
+void Map::parseRows(std::istream& in, bool allowUnvisited, bool stopAtBlankLine) {
+    clearTiles();
+    base.reset();
+    dropUndoLog();
+    pendingCodes.clear();
     width = 0;
     height = 0;
+    tileCount = 0;
+    chunkColumns = 0;
+    componentsDirty = true;
     chargerId = Tile::INVALID_ID;
 
-    std::vector<std::string> lines;
-    std::string line;
-    while (std::getline(in, line)) {
-        if (!line.empty()) {
-            lines.push_back(line);
+    // Mapa tekstowa nie może zaczynać się od 'R', więc wystarczy podejrzeć pierwszy znak
+    if (in.peek() == 'R') {
+        parseRle(in, allowUnvisited, stopAtBlankLine);
+        return;
+    }
+
+    // Kafelki są tworzone w trakcie czytania wiersza, bez kopiowania całego pliku
+    char buffer[READ_BUFFER_SIZE];
+    uint8_t codes[READ_BUFFER_SIZE];
+    size_t rowLength = 0;
+    bool endOfInput = false;
+
+    while (!endOfInput) {
+        in.getline(buffer, READ_BUFFER_SIZE);
+        size_t count = static_cast<size_t>(in.gcount());
+        bool rowEnded = true;
+
+        if (in.fail() && !in.eof() && count == READ_BUFFER_SIZE - 1) {
+            // Buffer filled before the end of the row - keep reading the same row
+            in.clear();
+            rowEnded = false;
+        }
+        else if (in.fail() || in.eof()) {
+            endOfInput = true;
+        }
+
+        if (!in.eof() && rowEnded && count > 0) {
+            count--; // gcount() includes the extracted '\n'
+        }
+
+        if (height > 0 && rowLength + count > width) {
+            throw std::runtime_error("Map is not rectangular - row " + std::to_string(height) + " has different length.");
+        }
+
+        MapCodec::DecodeResult decoded = MapCodec::decodeRow(buffer, count, codes, allowUnvisited);
+        if (decoded.chargerCount > 0) {
+            if (chargerId != Tile::INVALID_ID || decoded.chargerCount > 1) {
+                throw std::runtime_error("Map contains more than one charger.");
+            }
+            chargerId = tileCount + decoded.firstCharger;
+        }
+        if (decoded.invalidPos < count) {
+            throw std::runtime_error("Invalid character in map file: " + std::string(1, buffer[decoded.invalidPos]));
+        }
+
+        appendTiles(codes, count, false);
+        rowLength += count;
+
+        if (!rowEnded) {
+            continue;
+        }
+
+        if (rowLength == 0) {
+            if (stopAtBlankLine && !endOfInput) {
+                break;
+            }
+            continue;
+        }
+
+        if (height == 0) {
+            startChunks(rowLength);
         }
+        else if (rowLength != width) {
+            throw std::runtime_error("Map is not rectangular - row " + std::to_string(height) + " has different length.");
+        }
+        height++;
+        rowLength = 0;
     }
 
-    if (lines.empty()) {
+    if (tileCount == 0) {
         throw std::runtime_error("Map file is empty.");
     }
 
-    height = lines.size();
-    width = lines[0].length();
+    if (chargerId == Tile::INVALID_ID) {
+        throw std::runtime_error("Map must contain exactly one charger.");
+    }
+}
 
-    size_t idCounter = 0;
-    for (size_t i = 0; i < height; ++i) {
-        if (lines[i].length() != width) {
-            throw std::runtime_error("Map is not rectangular - row " + std::to_string(i) + " has different length.");
-        }
-        for (size_t j = 0; j < width; ++j) {
-            char tileChar = lines[i][j];
-            if (isdigit(tileChar)) {
-                tiles.push_back(std::make_unique<Floor>(idCounter, tileChar - '0'));
+void Map::parseRle(std::istream& in, bool allowUnvisited, bool stopAtBlankLine) {
+    std::string header;
+    std::getline(in, header);
+    std::istringstream headerStream(header);
+    std::string tag;
+    size_t mapWidth = 0;
+    size_t mapHeight = 0;
+    if (!(headerStream >> tag >> mapWidth >> mapHeight) || tag != "RLE" || mapWidth == 0 || mapHeight == 0) {
+        throw std::runtime_error("Invalid RLE map header: " + header);
+    }
+    if (mapWidth > chunks.max_size() / mapHeight) {
+        throw std::runtime_error("RLE map dimensions are too large.");
+    }
+    checkTileCount(mapWidth, mapHeight);
+
+    // Wymiary są znane z góry, więc siatka kawałków jest alokowana jednorazowo
+    startChunks(mapWidth);
+    growChunks((mapHeight + CHUNK_SIDE - 1) / CHUNK_SIDE * chunkColumns);
+
+    // Every run is "<count><tile>", the tile character being the last character of the token.
+    // Rows are read through the same fixed buffer as text maps, so runs may span buffer refills.
+    char buffer[READ_BUFFER_SIZE];
+    for (size_t row = 0; row < mapHeight; ++row) {
+        size_t rowLength = 0;
+        size_t count = 0;
+        char tileChar = '\0';
+        bool hasTileChar = false;
+
+        auto flushRun = [&]() {
+            if (!hasTileChar) {
+                return;
             }
-            else if (tileChar == 'P') {
-                tiles.push_back(std::make_unique<Obstacle>(idCounter));
+            if (count == 0 || rowLength + count > mapWidth) {
+                throw std::runtime_error("Invalid RLE run in row " + std::to_string(row) + ".");
+            }
+            uint8_t code;
+            MapCodec::DecodeResult decoded = MapCodec::decodeRow(&tileChar, 1, &code, allowUnvisited);
+            if (decoded.invalidPos == 0) {
+                throw std::runtime_error("Invalid character in map file: " + std::string(1, tileChar));
             }
-            else if (tileChar == 'B') {
-                tiles.push_back(std::make_unique<Charger>(idCounter));
-                if (chargerId != Tile::INVALID_ID) {
+            if (decoded.chargerCount > 0) {
+                if (chargerId != Tile::INVALID_ID || count > 1) {
                     throw std::runtime_error("Map contains more than one charger.");
                 }
-                chargerId = idCounter;
+                chargerId = tileCount;
             }
-            else if (tileChar == '?' && allowUnvisited) {
-                tiles.push_back(std::make_unique<UnVisited>(idCounter));
+            appendTiles(&code, count, true);
+            rowLength += count;
+            count = 0;
+            hasTileChar = false;
+        };
+
+        bool rowEnded = false;
+        while (!rowEnded) {
+            in.getline(buffer, READ_BUFFER_SIZE);
+            size_t read = static_cast<size_t>(in.gcount());
+            if (in.fail() && !in.eof() && read == READ_BUFFER_SIZE - 1) {
+                in.clear();
+            }
+            else if (read == 0 && in.fail()) {
+                throw std::runtime_error("RLE map ended before row " + std::to_string(row) + " was complete.");
             }
             else {
-                throw std::runtime_error("Invalid character in map file: " + std::string(1, tileChar));
+                rowEnded = true;
+                if (!in.eof()) {
+                    read--; // gcount() includes the extracted '\n'
+                }
+            }
+
+            for (size_t i = 0; i < read; ++i) {
+                if (buffer[i] == ' ') {
+                    flushRun();
+                    continue;
+                }
+                // The previous character turned out to be a digit of the count
+                if (hasTileChar) {
+                    if (!isdigit(static_cast<unsigned char>(tileChar)) || count > mapWidth) {
+                        throw std::runtime_error("Invalid RLE run in row " + std::to_string(row) + ".");
+                    }
+                    count = count * 10 + static_cast<size_t>(tileChar - '0');
+                }
+                tileChar = buffer[i];
+                hasTileChar = true;
             }
-            idCounter++;
         }
+        flushRun();
+
+        if (rowLength != mapWidth) {
+            throw std::runtime_error("Map is not rectangular - row " + std::to_string(row) + " has different length.");
+        }
+    }
+    height = mapHeight;
+
+    // Consume the empty line separating the map from the rest of the file
+    if (stopAtBlankLine && in.peek() == '\n') {
+        in.get();
     }
 
     if (chargerId == Tile::INVALID_ID) {
@@ -150,18 +671,263 @@ void Map::loadMap(std::istream& in, bool allowUnvisited) {
     }
 }
 
-void Map::updateTile(size_t tileId, const Tile* tileObj) {
-    if (tileId >= tiles.size()) {
+void Map::checkTileCount(size_t mapWidth, size_t mapHeight) {
+    if (mapHeight != 0 && mapWidth > MAX_TILE_COUNT / mapHeight) {
+        throw std::runtime_error("Map has more tiles than TileIndex can address - build with ROBOT_TILE_INDEX_64.");
+    }
+}
+
+void Map::appendTiles(const uint8_t* codes, size_t count, bool repeat) {
+    checkTileCount(tileCount + count, 1);
+    const size_t firstId = tileCount;
+    tileCount += count;
+    if (width != 0) {
+        placeTiles(firstId, codes, count, repeat);
+    }
+    else if (repeat) {
+        pendingCodes.insert(pendingCodes.end(), count, codes[0]);
+    }
+    else {
+        pendingCodes.insert(pendingCodes.end(), codes, codes + count);
+    }
+}
+
+uint8_t Map::tileCode(const Tile* tile) {
+    switch (tile->getKind()) {
+    case TileKind::floor:
+        return static_cast<uint8_t>(static_cast<const Floor*>(tile)->getCleanliness());
+    case TileKind::obstacle:
+        return MapCodec::OBSTACLE;
+    case TileKind::charger:
+        return MapCodec::CHARGER;
+    default:
+        return MapCodec::UNVISITED;
+    }
+}
+
+bool Map::updateTile(size_t tileId, const Tile* tileObj) {
+    if (tileId >= tileCount) {
         throw std::out_of_range("Tile ID out of range");
     }
 
-    // Always replace the tile with a copy of the given tile
-    tiles[tileId] = tileObj->clone();
-    tiles[tileId]->setId(tileId);
+    const size_t chunk = chunkOf(tileId);
+    if (!chunks[chunk]) {
+        // Kawałek jest tworzony (albo kopiowany z bazy) tylko przy rzeczywistej zmianie
+        const Tile* known = getTile(tileId);
+        if (known->getKind() == tileObj->getKind() && (known->getKind() != TileKind::floor
+            || static_cast<const Floor*>(known)->getCleanliness() == static_cast<const Floor*>(tileObj)->getCleanliness())) {
+            return false;
+        }
+        materialize(chunk, SIZE_MAX);
+    }
+    Tile*& slot = chunks[chunk]->tiles[slotOf(tileId)];
+    Tile* current = slot;
+    const TileKind previousKind = current->getKind();
+    if (previousKind == tileObj->getKind()) {
+        // Ten sam rodzaj - wystarczy przepisać poziom brudu, bez alokacji
+        if (previousKind != TileKind::floor) {
+            return false;
+        }
+        Floor* floor = static_cast<Floor*>(current);
+        const unsigned int cleanliness = static_cast<const Floor*>(tileObj)->getCleanliness();
+        if (floor->getCleanliness() == cleanliness) {
+            return false;
+        }
+        recordTile(tileId);
+        floor->setCleanliness(cleanliness);
+    }
+    else {
+        // Zmiana rodzaju wymaga nowego obiektu
+        recordTile(tileId);
+        const bool wasWalkable = current->isWalkable();
+        slot = createTile(tileCode(tileObj));
+        destroyTile(current);
+
+        const bool isWalkable = slot->isWalkable();
+        if (base && wasWalkable != isWalkable) {
+            // Inny układ przejść niż w bazie - składowe bazy przestają pasować
+            detachBase();
+        }
+        setWalkable(tileId % width, tileId / width, isWalkable);
+        if (wasWalkable && !isWalkable) {
+            // Zablokowany kafelek może rozdzielić składową - przebudowa przy następnym zapytaniu
+            componentsDirty = true;
+        }
+        else if (!wasWalkable && isWalkable && !componentsDirty) {
+            parentOf(tileId) = static_cast<TileIndex>(tileId);
+            forEachWalkableNeighbour(tileId, [&](size_t neighbour) { uniteComponents(tileId, neighbour); });
+        }
+    }
+
+    if (tileChangeListener) {
+        tileChangeListener(tileId, previousKind);
+    }
+    return true;
+}
+
+DistanceMatrix Map::distances(const std::vector<size_t>& sources, const std::vector<size_t>& targets,
+    unsigned threads) const {
+    return DistanceMatrix::compute(*this, sources, targets, threads);
+}
+
+size_t Map::findComponent(size_t tileId) const {
+    // Skracanie ścieżek przez połowienie. Po przebudowie każdy kafelek wskazuje korzeń,
+    // więc nic nie jest zapisywane i współdzieloną bazę można czytać z wielu wątków.
+    while (parentOf(tileId) != tileId) {
+        TileIndex& parent = parentOf(tileId);
+        const TileIndex grandparent = parentOf(parent);
+        if (grandparent != parent) {
+            parent = grandparent;
+        }
+        tileId = parent;
+    }
+    return tileId;
+}
+
+void Map::uniteComponents(size_t first, size_t second) const {
+    first = findComponent(first);
+    second = findComponent(second);
+    if (first != second) {
+        // Mniejszy indeks zostaje korzeniem, więc etykiety nie zależą od kolejności łączenia
+        if (first < second) {
+            parentOf(second) = static_cast<TileIndex>(first);
+        }
+        else {
+            parentOf(first) = static_cast<TileIndex>(second);
+        }
+    }
+}
+
+void Map::rebuildComponents() const {
+    // Niezapisane kawałki nie mają kafelków, po których można jeździć - są pomijane w całości
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (chunks[c]) {
+            Chunk& chunk = *chunks[c];
+            if (!chunk.componentParent) {
+                chunk.componentParent = std::make_unique<TileIndex[]>(CHUNK_TILES);
+            }
+            forEachChunkTile(c, [&](size_t tileId, size_t slot) {
+                const Tile* tile = chunk.tiles[slot];
+                chunk.componentParent[slot] = tile && tile->isWalkable() ? static_cast<TileIndex>(tileId) : NO_TILE;
+            });
+        }
+    }
+    // Wystarczy łączyć z sąsiadem z lewej i z góry
+    auto hasComponent = [this](size_t tileId) {
+        return chunks[chunkOf(tileId)] && parentOf(tileId) != NO_TILE;
+    };
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c]) {
+            continue;
+        }
+        forEachChunkTile(c, [&](size_t tileId, size_t slot) {
+            if (chunks[c]->componentParent[slot] == NO_TILE) {
+                return;
+            }
+            if (tileId % width != 0 && hasComponent(tileId - 1)) {
+                uniteComponents(tileId, tileId - 1);
+            }
+            if (tileId >= width && hasComponent(tileId - width)) {
+                uniteComponents(tileId, tileId - width);
+            }
+        });
+    }
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        if (!chunks[c]) {
+            continue;
+        }
+        forEachChunkTile(c, [&](size_t tileId, size_t slot) {
+            if (chunks[c]->componentParent[slot] != NO_TILE) {
+                chunks[c]->componentParent[slot] = static_cast<TileIndex>(findComponent(tileId));
+            }
+        });
+    }
+    componentsDirty = false;
+}
+
+void Map::prepareComponents() const {
+    if (base) {
+        base->prepareComponents();
+    }
+    else if (componentsDirty) {
+        rebuildComponents();
+    }
+}
+
+size_t Map::getComponent(size_t tileId) const {
+    if (tileId >= tileCount) {
+        return NO_COMPONENT;
+    }
+    if (base) {
+        return base->getComponent(tileId);
+    }
+    if (componentsDirty) {
+        rebuildComponents();
+    }
+    if (!chunks[chunkOf(tileId)] || parentOf(tileId) == NO_TILE) {
+        return NO_COMPONENT;
+    }
+    return findComponent(tileId);
+}
+
+bool Map::isReachable(size_t fromId, size_t toId) const {
+    const size_t component = getComponent(fromId);
+    return component != NO_COMPONENT && component == getComponent(toId);
+}
+
+void Map::setTileChangeListener(TileChangeListener listener) {
+    tileChangeListener = std::move(listener);
+}
+
+size_t Map::snapshot() {
+    recordingUndo = true;
+    return undoLog.size();
+}
+
+void Map::rollback(size_t snapshot) {
+    if (!recordingUndo || snapshot > undoLog.size()) {
+        throw std::runtime_error("Map snapshot no longer exists.");
+    }
+    // Od końca, więc kafelek zapisany kilka razy wraca do najstarszego stanu.
+    // Przywracanie idzie przez updateTile, żeby składowe i słuchacz widziały zmiany.
+    recordingUndo = false;
+    Floor floor;
+    Obstacle obstacle;
+    Charger charger;
+    UnVisited unvisited;
+    while (undoLog.size() > snapshot) {
+        const UndoEntry entry = undoLog.back();
+        undoLog.pop_back();
+        const Tile* previous = &unvisited;
+        switch (entry.code) {
+        case MapCodec::OBSTACLE:
+            previous = &obstacle;
+            break;
+        case MapCodec::CHARGER:
+            previous = &charger;
+            break;
+        case MapCodec::UNVISITED:
+            break;
+        default:
+            floor.setCleanliness(entry.code);
+            previous = &floor;
+        }
+        updateTile(entry.tileId, previous);
+    }
+    recordingUndo = true;
+}
+
+void Map::commit() noexcept {
+    dropUndoLog();
+}
+
+void Map::dropUndoLog() noexcept {
+    undoLog.clear();
+    recordingUndo = false;
 }
 
 std::optional<size_t> Map::getIndex(size_t position, Direction direction) const {
-    if (position >= tiles.size()) {
+    if (position >= tileCount) {
         return std::nullopt;
     }
 
@@ -191,27 +957,48 @@ std::optional<size_t> Map::getIndex(size_t position, Direction direction) const
     }
 }
 
-Tile* Map::getTile(size_t index) {
-    if (index < tiles.size()) {
-        return tiles[index].get();
+Floor* Map::editFloor(size_t index) {
+    const Tile* tile = getTile(index);
+    if (!tile || !tile->isFloor()) {
+        return nullptr;
     }
-    return nullptr;
+    const size_t chunk = chunkOf(index);
+    if (!chunks[chunk]) {
+        materialize(chunk, SIZE_MAX);
+    }
+    // Wywołujący zmieni zabrudzenie kafelka
+    recordTile(index);
+    return chunks[chunk]->tiles[slotOf(index)]->asFloor();
 }
 
-
 const Tile* Map::getTile(size_t index) const {
-    if (index < tiles.size()) {
-        return tiles[index].get();
+    if (index >= tileCount || width == 0) {
+        return nullptr;
     }
-    return nullptr;
+    const Chunk* chunk = findChunk(chunkOf(index));
+    return chunk ? chunk->tiles[slotOf(index)] : &unvisitedTile();
 }
 
-Tile* Map::getTile(size_t index, Direction direction) {
-    std::optional<size_t> tileIndex = getIndex(index, direction);
-    if (tileIndex) {
-        return getTile(*tileIndex);
+size_t Map::getId(const Tile* tile) const {
+    if (!tile || tile == &unvisitedTile()) {
+        return Tile::INVALID_ID;
     }
-    return nullptr;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        const Chunk* chunk = findChunk(c);
+        if (!chunk) {
+            continue;
+        }
+        size_t found = Tile::INVALID_ID;
+        forEachChunkTile(c, [&](size_t tileId, size_t slot) {
+            if (chunk->tiles[slot] == tile) {
+                found = tileId;
+            }
+        });
+        if (found != Tile::INVALID_ID) {
+            return found;
+        }
+    }
+    return Tile::INVALID_ID;
 }
 
 const Tile* Map::getTile(size_t index, Direction direction) const {
@@ -222,34 +1009,69 @@ const Tile* Map::getTile(size_t index, Direction direction) const {
     return nullptr;
 }
 
-void Map::saveMap(std::ostream& os) const {
-    if (tiles.empty()) {
+void Map::rowCodes(size_t row, uint8_t* codes) const {
+    // Cały niezapisany kawałek w wierszu to jeden ciąg nieodwiedzonych kafelków
+    for (size_t first = 0; first < width; first += CHUNK_SIDE) {
+        const size_t last = std::min(width, first + CHUNK_SIDE);
+        const Chunk* chunk = findChunk(row / CHUNK_SIDE * chunkColumns + first / CHUNK_SIDE);
+        if (!chunk) {
+            std::fill(codes + first, codes + last, MapCodec::UNVISITED);
+            continue;
+        }
+        for (size_t x = first; x < last; ++x) {
+            codes[x] = tileCode(chunk->tiles[slotAt(x - first, row % CHUNK_SIDE)]);
+        }
+    }
+}
+
+void Map::saveMap(std::ostream& os, MapFormat format) const {
+    if (tileCount == 0) {
         os << "Map is empty.";
         return;
     }
 
+    if (format == MapFormat::rle) {
+        saveRle(os);
+        return;
+    }
+
+    // Whole rows are encoded at once and written with a single call
+    std::vector<uint8_t> codes(width);
+    std::string row(width + 1, '\n');
     for (size_t i = 0; i < height; ++i) {
-        for (size_t j = 0; j < width; ++j) {
-            size_t index = i * width + j;
-            const Tile* tile = tiles[index].get();
+        rowCodes(i, codes.data());
+        MapCodec::encodeRow(codes.data(), width, &row[0]);
+        os.write(row.data(), row.size());
+    }
+}
 
-            if (const Floor* floor = dynamic_cast<const Floor*>(tile)) {
-                os << static_cast<char>('0' + floor->getCleanliness());
-            }
-            else if (dynamic_cast<const Obstacle*>(tile)) {
-                os << 'P';
-            }
-            else if (dynamic_cast<const Charger*>(tile)) {
-                os << 'B';
-            }
-            else if (dynamic_cast<const UnVisited*>(tile)) {
-                os << '?';
+void Map::saveRle(std::ostream& os) const {
+    os << "RLE " << width << ' ' << height << '\n';
+
+    std::string row;
+    std::vector<uint8_t> codes(width);
+    for (size_t i = 0; i < height; ++i) {
+        row.clear();
+        rowCodes(i, codes.data());
+        size_t j = 0;
+        while (j < width) {
+            uint8_t code = codes[j];
+            size_t runEnd = j + 1;
+            while (runEnd < width && codes[runEnd] == code) {
+                runEnd++;
             }
-            else {
-                os << '?';
+
+            char tileChar;
+            MapCodec::encodeRow(&code, 1, &tileChar);
+            if (!row.empty()) {
+                row += ' ';
             }
+            row += std::to_string(runEnd - j);
+            row += tileChar;
+            j = runEnd;
         }
-        os << '\n';
+        row += '\n';
+        os.write(row.data(), row.size());
     }
 }
 
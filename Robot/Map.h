@@ -1,13 +1,19 @@
 #pragma once
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <iostream>
 #include <optional>
+#include <cstdint>
+#include <functional>
 #include "Tile.h"
 #include "Obstacle.h"
 #include "Charger.h"
 #include "Floor.h"
 #include "UnVisited.h"
+#include "DistanceMatrix.h"
+#include "TileLayout.h"
+#include "TileIndex.h"
 
 enum class Direction {
     up,
@@ -17,12 +23,144 @@ enum class Direction {
     none
 };
 
+// Format zapisu mapy; rle zaczyna się nagłówkiem "RLE <szerokość> <wysokość>"
+enum class MapFormat {
+    text,
+    rle
+};
+
 class Map {
+public:
+    static constexpr size_t NO_COMPONENT = SIZE_MAX;
+    static constexpr size_t CHUNK_SIDE = 64;
+    // Order of tiles inside a chunk, chosen at compile time; tile ids don't depend on it
+    using Layout = MapTileLayout;
+
+    // Wywoływany tylko przy rzeczywistej zmianie kafelka: (id, poprzedni rodzaj)
+    using TileChangeListener = std::function<void(size_t tileId, TileKind previousKind)>;
+
 private:
+    // Rozmiar bufora odczytu - wiersze dłuższe są parsowane kawałkami
+    static constexpr size_t READ_BUFFER_SIZE = 4096;
+
+    static constexpr size_t CHUNK_TILES = CHUNK_SIDE * CHUNK_SIDE;
+    // Siatka przejezdności kawałka z ramką jednego pola: sąsiedzi komórki leżą o ±1 i ±GRID_SIDE
+    static constexpr size_t GRID_SIDE = CHUNK_SIDE + 2;
+    static constexpr size_t GRID_CELLS = GRID_SIDE * GRID_SIDE;
+    // Siatka kawałków bez żadnego przejezdnego pola, także w ramce
+    static constexpr uint8_t EMPTY_GRID[GRID_CELLS] = {};
+
+    // Kafelki kwadratu CHUNK_SIDE x CHUNK_SIDE w kolejności Layout; pola poza mapą są puste.
+    // Spójne składowe kafelków, po których można jeździć (union-find), są trzymane obok kafelków.
+    struct Chunk {
+        Tile* tiles[CHUNK_TILES] = {};                // Owned by the map, see createTile
+        std::unique_ptr<TileIndex[]> componentParent; // Created when components are first needed; NO_TILE off the floor
+    };
+
     size_t width = 0;
     size_t height = 0;
-    std::vector<std::unique_ptr<Tile>> tiles;
+    size_t tileCount = 0;       // Tiles created so far; width * height once the map is loaded
+    size_t chunkColumns = 0;
+    // Kawałek jest tworzony przy pierwszym zapisie. Brakujący kawałek to same nieodwiedzone
+    // kafelki, więc pamięć robota rośnie razem ze zbadanym obszarem.
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<uint8_t> pendingCodes; // First row of a text map, until its width is known
+    // Przejezdność kafelków kawałka wiersz po wierszu, w ramce skrajne kafelki sąsiednich kawałków
+    // (poza mapą zera), więc sąsiedzi są sprawdzani bez warunków brzegowych. Siatka kawałka powstaje
+    // przy pierwszym przejezdnym kafelku w nim lub w jego ramce; własne siatki leżą jedna za drugą.
+    std::vector<uint8_t> gridCells;
+    // Siatka czytana dla każdego kawałka: własna, bazy albo EMPTY_GRID. Nakładka czyta siatki
+    // bazy - zmiana przejezdności i tak odłącza ją od bazy.
+    std::vector<const uint8_t*> grids;
     size_t chargerId = 0;
+    // Niezmienna mapa, z której nakładka czyta kawałki, których sama nie ma. Kawałek jest
+    // kopiowany przy pierwszym zapisie, więc wiele symulacji dzieli jeden układ ścian.
+    std::shared_ptr<const Map> base;
+    TileChangeListener tileChangeListener; // Nie jest kopiowany razem z mapą
+
+    // Składowe są przebudowywane leniwie po zablokowaniu kafelka, łączone od razu po odblokowaniu
+    mutable bool componentsDirty = true;
+
+    // Dziennik cofania: poprzedni kod kafelka przed zmianą przez updateTile albo przed
+    // wydaniem go do zapisu przez editFloor. Kafelek może wystąpić wiele razy.
+    struct UndoEntry {
+        TileIndex tileId;
+        uint8_t code;
+    };
+    std::vector<UndoEntry> undoLog;
+    bool recordingUndo = false;
+
+    // Kafelki są alokowane z tileResource. Domyślnie to własna pula mapy, tworzona przy pierwszym
+    // kafelku i zwalniana w całości przy zniszczeniu lub ponownym wczytaniu mapy.
+    std::pmr::memory_resource* tileResource = nullptr;
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> ownPool;
+
+    void recordTile(size_t tileId) {
+        if (recordingUndo) {
+            undoLog.push_back({ static_cast<TileIndex>(tileId), tileCode(getTile(tileId)) });
+        }
+    }
+    void dropUndoLog() noexcept;
+
+    // Chunk and slot of a tile inside the map
+    size_t chunkOf(size_t tileId) const noexcept {
+        const size_t row = tileId / width;
+        return row / CHUNK_SIDE * chunkColumns + (tileId - row * width) / CHUNK_SIDE;
+    }
+    size_t slotOf(size_t tileId) const noexcept {
+        const size_t row = tileId / width;
+        return slotAt((tileId - row * width) % CHUNK_SIDE, row % CHUNK_SIDE);
+    }
+    // Slot of the tile at (x, y) inside its chunk
+    static constexpr size_t slotAt(size_t x, size_t y) noexcept { return Layout::slot(x, y, CHUNK_SIDE); }
+    // Cell of the tile in its chunk's grid
+    const uint8_t* cellOf(size_t tileId) const noexcept {
+        const size_t row = tileId / width;
+        const size_t column = tileId - row * width;
+        return grids[row / CHUNK_SIDE * chunkColumns + column / CHUNK_SIDE]
+            + (row % CHUNK_SIDE + 1) * GRID_SIDE + column % CHUNK_SIDE + 1;
+    }
+    // Stores walkability of the tile in its chunk's grid and in the frames of the neighbouring chunks
+    void setWalkable(size_t column, size_t row, bool walkable);
+    void setGridCell(size_t chunk, size_t cell, bool walkable);
+    void addGrid(size_t chunk);
+    // Adds chunks up to count; their top frames get the walkable tiles of the chunks above
+    void growChunks(size_t count);
+    // Own copies of the grids the other map reads; a copy of an overlay keeps reading the shared base
+    void copyGrids(const Map& other);
+    // Own chunk or the base's one, nullptr when neither was written
+    const Chunk* findChunk(size_t chunk) const {
+        return chunks[chunk] ? chunks[chunk].get() : base ? base->findChunk(chunk) : nullptr;
+    }
+    // Creates the chunk as a copy of the base's one; otherwise tiles with ids below filledBefore become UnVisited
+    Chunk& materialize(size_t chunk, size_t filledBefore);
+    // Copies every remaining base chunk and drops the base
+    void detachBase();
+    // After this const queries of the map no longer modify it
+    void prepareComponents() const;
+    void startChunks(size_t mapWidth);
+    // Places count tiles starting at firstId; repeat uses codes[0] for all of them
+    void placeTiles(size_t firstId, const uint8_t* codes, size_t count, bool repeat);
+    std::pmr::memory_resource& tileMemory();
+    Tile* createTile(uint8_t code);
+    void destroyTile(Tile* tile) noexcept;
+    // Calls fn(tileId, slot) for every tile of a created chunk
+    template <typename Fn>
+    void forEachChunkTile(size_t chunk, Fn&& fn) const;
+    TileIndex& parentOf(size_t tileId) const { return chunks[chunkOf(tileId)]->componentParent[slotOf(tileId)]; }
+    void rowCodes(size_t row, uint8_t* codes) const;
+    void copyTiles(const Map& other);
+    void clearTiles();
+    void parseRows(std::istream& in, bool allowUnvisited, bool stopAtBlankLine);
+    void parseRle(std::istream& in, bool allowUnvisited, bool stopAtBlankLine);
+    // Throws std::runtime_error when width * height tiles don't fit in TileIndex
+    static void checkTileCount(size_t mapWidth, size_t mapHeight);
+    void appendTiles(const uint8_t* codes, size_t count, bool repeat);
+    void saveRle(std::ostream& os) const;
+    static uint8_t tileCode(const Tile* tile);
+    size_t findComponent(size_t tileId) const;
+    void uniteComponents(size_t first, size_t second) const;
+    void rebuildComponents() const;
 
 public:
     // Constructors and destructor
@@ -30,13 +168,22 @@ public:
     Map(std::istream& in);
     Map(std::istream& in, bool allowUnvisited);
     Map(size_t mapWidth, size_t mapHeight, size_t chargerTileId);
+    // Empty map whose tiles are allocated and freed one by one from tileResource, which must outlive it;
+    // nullptr keeps the map's own pool. Copies of the map use their own pool again.
+    explicit Map(std::pmr::memory_resource* tileResource);
+    // Overlay of baseMap: reads fall through to the base, written chunks are copied first.
+    // Changing whether a tile is walkable copies the whole base.
+    explicit Map(std::shared_ptr<const Map> baseMap);
+
+    // Immutable base for overlays, safe to read from many threads
+    static std::shared_ptr<const Map> share(Map map);
 
     // Rule of five
-    ~Map() = default;
+    ~Map();
     Map(const Map& other);
     Map& operator=(const Map& other);
-    Map(Map&& other) noexcept = default;
-    Map& operator=(Map&& other) noexcept = default;
+    Map(Map&& other) noexcept;
+    Map& operator=(Map&& other) noexcept;
 
     // Getters
     size_t getWidth() const noexcept;
@@ -44,19 +191,69 @@ public:
     size_t getChargerId() const noexcept;
     size_t getSize() const { return height * width; }
     std::optional<size_t> getIndex(size_t position, Direction direction) const;
+    // Calls fn(neighbourId) for every walkable neighbour of tileId, in the order up, down, left, right.
+    // One division per call and no bounds checks; tileId itself doesn't have to be walkable.
+    template <typename Fn>
+    void forEachWalkableNeighbour(size_t tileId, Fn&& fn) const {
+        const uint8_t* cell = cellOf(tileId);
+        if (*(cell - GRID_SIDE)) {
+            fn(tileId - width);
+        }
+        if (*(cell + GRID_SIDE)) {
+            fn(tileId + width);
+        }
+        if (*(cell - 1)) {
+            fn(tileId - 1);
+        }
+        if (*(cell + 1)) {
+            fn(tileId + 1);
+        }
+    }
+
+    // Chunks of CHUNK_SIDE x CHUNK_SIDE tiles; a chunk that was never written holds only unvisited tiles.
+    // Loaded chunks are the ones owned by this map, for an overlay the ones copied from its base.
+    size_t getChunkCount() const noexcept { return chunks.size(); }
+    size_t getLoadedChunkCount() const noexcept;
+    bool isChunkLoaded(size_t tileId) const { return tileId < tileCount && chunks[chunkOf(tileId)] != nullptr; }
+    const std::shared_ptr<const Map>& getBase() const noexcept { return base; }
 
     // Map operations
     bool isMapValid() const;
     bool isMapValid(bool allowUnvisited) const;
     bool canMoveOn(size_t tileId) const;
+    // Label shared by all walkable tiles connected to tileId, NO_COMPONENT for other tiles
+    size_t getComponent(size_t tileId) const;
+    bool isReachable(size_t fromId, size_t toId) const;
+    // Steps from every source to every target in one search per source, see DistanceMatrix::compute
+    DistanceMatrix distances(const std::vector<size_t>& sources, const std::vector<size_t>& targets,
+        unsigned threads = 1) const;
     void loadMap(std::istream& in);
     void loadMap(std::istream& in, bool allowUnvisited);
-    void saveMap(std::ostream& os) const;
-    void updateTile(size_t tileId, const Tile* tileObj);
-    Tile* getTile(size_t index);
+    // Text and RLE maps are detected from the first line
+    // Reads rows up to the first empty line, leaving the rest of the stream unread
+    void loadMapSection(std::istream& in, bool allowUnvisited);
+    void saveMap(std::ostream& os, MapFormat format = MapFormat::text) const;
+    // Copies kind and dirt of tileObj; returns false when the tile already matched
+    bool updateTile(size_t tileId, const Tile* tileObj);
+    void setTileChangeListener(TileChangeListener listener);
+
+    // Snapshot for lookahead: from now on changed tiles are logged, rollback restores them
+    // in time proportional to the changes. Snapshots nest; loading or assigning the map drops them.
+    size_t snapshot();
+    // Throws std::runtime_error when the snapshot no longer exists
+    void rollback(size_t snapshot);
+    // Keeps the changes, drops all snapshots and stops logging
+    void commit() noexcept;
+    bool hasSnapshot() const noexcept { return recordingUndo; }
+    // Tiles of chunks that were never written share one UnVisited object
     const Tile* getTile(size_t index) const;
-    Tile* getTile(size_t index, Direction direction);
     const Tile* getTile(size_t index, Direction direction) const;
+    // Floor whose dirt the caller changes, nullptr for other tiles. Copies the chunk from the base
+    // map and logs the tile for rollback - the pointer must not be kept across snapshot().
+    Floor* editFloor(size_t index);
+    // Position of a tile returned by getTile, Tile::INVALID_ID for tiles of other maps and the shared
+    // unvisited tile. Searches the loaded chunks - code that walks the map already has the id.
+    size_t getId(const Tile* tile) const;
 
     // Output operator
     friend std::ostream& operator<<(std::ostream& os, const Map& map);
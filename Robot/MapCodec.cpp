@@ -0,0 +1,334 @@
+#include "MapCodec.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MAP_CODEC_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MAP_CODEC_TARGET(name) __attribute__((target(name)))
+#else
+#define MAP_CODEC_TARGET(name)
+#endif
+
+namespace {
+    // Znaki odpowiadające kodom; indeksy 13-15 nie są używane
+    constexpr char CODE_CHARS[16] = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'P', 'B', '?', '?', '?', '?'
+    };
+
+    uint8_t decodeChar(char c, bool allowUnvisited) {
+        if (c >= '0' && c <= '9') {
+            return static_cast<uint8_t>(c - '0');
+        }
+        if (c == 'P') {
+            return MapCodec::OBSTACLE;
+        }
+        if (c == 'B') {
+            return MapCodec::CHARGER;
+        }
+        if (c == '?' && allowUnvisited) {
+            return MapCodec::UNVISITED;
+        }
+        return MapCodec::INVALID;
+    }
+
+    // Processes src[begin, count) one character at a time, used by the tails of the vector kernels
+    MapCodec::DecodeResult decodeScalarFrom(const char* src, size_t begin, size_t count, uint8_t* codes,
+        bool allowUnvisited, MapCodec::DecodeResult result) {
+        for (size_t i = begin; i < count; ++i) {
+            uint8_t code = decodeChar(src[i], allowUnvisited);
+            codes[i] = code;
+            if (code == MapCodec::INVALID) {
+                result.invalidPos = i;
+                return result;
+            }
+            if (code == MapCodec::CHARGER) {
+                if (result.chargerCount == 0) {
+                    result.firstCharger = i;
+                }
+                result.chargerCount++;
+            }
+        }
+        return result;
+    }
+
+    MapCodec::DecodeResult decodeScalar(const char* src, size_t count, uint8_t* codes, bool allowUnvisited) {
+        return decodeScalarFrom(src, 0, count, codes, allowUnvisited, { count, 0, count });
+    }
+
+    void encodeScalarFrom(const uint8_t* codes, size_t begin, size_t count, char* dst) {
+        for (size_t i = begin; i < count; ++i) {
+            dst[i] = codes[i] < 16 ? CODE_CHARS[codes[i]] : '?';
+        }
+    }
+
+    void encodeScalar(const uint8_t* codes, size_t count, char* dst) {
+        encodeScalarFrom(codes, 0, count, dst);
+    }
+
+    unsigned countTrailingZeros(unsigned mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    unsigned popCount(unsigned mask) {
+        unsigned count = 0;
+        for (; mask; mask &= mask - 1) {
+            count++;
+        }
+        return count;
+    }
+
+    // Records the chargers of one block and the position of its first invalid character.
+    // Returns true when decoding has to stop.
+    bool accountBlock(size_t base, unsigned invalidMask, unsigned chargerMask, MapCodec::DecodeResult& result) {
+        if (invalidMask) {
+            unsigned firstInvalid = countTrailingZeros(invalidMask);
+            chargerMask &= (1u << firstInvalid) - 1u;
+            result.invalidPos = base + firstInvalid;
+        }
+        if (chargerMask) {
+            if (result.chargerCount == 0) {
+                result.firstCharger = base + countTrailingZeros(chargerMask);
+            }
+            result.chargerCount += popCount(chargerMask);
+        }
+        return invalidMask != 0;
+    }
+
+#ifdef MAP_CODEC_X86
+    MapCodec::DecodeResult decodeSse2(const char* src, size_t count, uint8_t* codes, bool allowUnvisited) {
+        MapCodec::DecodeResult result{ count, 0, count };
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i obstacleChar = _mm_set1_epi8('P');
+        const __m128i chargerChar = _mm_set1_epi8('B');
+        const __m128i unvisitedChar = _mm_set1_epi8('?');
+        const __m128i unvisitedAllowed = _mm_set1_epi8(allowUnvisited ? -1 : 0);
+        const __m128i obstacleCode = _mm_set1_epi8(MapCodec::OBSTACLE);
+        const __m128i chargerCode = _mm_set1_epi8(MapCodec::CHARGER);
+        const __m128i unvisitedCode = _mm_set1_epi8(MapCodec::UNVISITED);
+        const __m128i invalidCode = _mm_set1_epi8(static_cast<char>(MapCodec::INVALID));
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i digit = _mm_sub_epi8(c, zeroChar);
+            __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit);
+            __m128i isObstacle = _mm_cmpeq_epi8(c, obstacleChar);
+            __m128i isCharger = _mm_cmpeq_epi8(c, chargerChar);
+            __m128i isUnvisited = _mm_and_si128(_mm_cmpeq_epi8(c, unvisitedChar), unvisitedAllowed);
+            __m128i valid = _mm_or_si128(_mm_or_si128(isDigit, isObstacle), _mm_or_si128(isCharger, isUnvisited));
+
+            __m128i code = _mm_and_si128(isDigit, digit);
+            code = _mm_or_si128(code, _mm_and_si128(isObstacle, obstacleCode));
+            code = _mm_or_si128(code, _mm_and_si128(isCharger, chargerCode));
+            code = _mm_or_si128(code, _mm_and_si128(isUnvisited, unvisitedCode));
+            code = _mm_or_si128(code, _mm_andnot_si128(valid, invalidCode));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(codes + i), code);
+
+            unsigned invalidMask = ~static_cast<unsigned>(_mm_movemask_epi8(valid)) & 0xFFFFu;
+            unsigned chargerMask = static_cast<unsigned>(_mm_movemask_epi8(isCharger));
+            if (accountBlock(i, invalidMask, chargerMask, result)) {
+                return result;
+            }
+        }
+        return decodeScalarFrom(src, i, count, codes, allowUnvisited, result);
+    }
+
+    void encodeSse2(const uint8_t* codes, size_t count, char* dst) {
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        const __m128i obstacleCode = _mm_set1_epi8(MapCodec::OBSTACLE);
+        const __m128i chargerCode = _mm_set1_epi8(MapCodec::CHARGER);
+        const __m128i obstacleChar = _mm_set1_epi8('P');
+        const __m128i chargerChar = _mm_set1_epi8('B');
+        const __m128i unknownChar = _mm_set1_epi8('?');
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m128i code = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i));
+            __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(code, nine), code);
+            __m128i isObstacle = _mm_cmpeq_epi8(code, obstacleCode);
+            __m128i isCharger = _mm_cmpeq_epi8(code, chargerCode);
+            __m128i known = _mm_or_si128(isDigit, _mm_or_si128(isObstacle, isCharger));
+
+            __m128i out = _mm_and_si128(isDigit, _mm_add_epi8(code, zeroChar));
+            out = _mm_or_si128(out, _mm_and_si128(isObstacle, obstacleChar));
+            out = _mm_or_si128(out, _mm_and_si128(isCharger, chargerChar));
+            out = _mm_or_si128(out, _mm_andnot_si128(known, unknownChar));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+        }
+        encodeScalarFrom(codes, i, count, dst);
+    }
+
+    MAP_CODEC_TARGET("avx2")
+    MapCodec::DecodeResult decodeAvx2(const char* src, size_t count, uint8_t* codes, bool allowUnvisited) {
+        MapCodec::DecodeResult result{ count, 0, count };
+        const __m256i zeroChar = _mm256_set1_epi8('0');
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i obstacleChar = _mm256_set1_epi8('P');
+        const __m256i chargerChar = _mm256_set1_epi8('B');
+        const __m256i unvisitedChar = _mm256_set1_epi8('?');
+        const __m256i unvisitedAllowed = _mm256_set1_epi8(allowUnvisited ? -1 : 0);
+        const __m256i obstacleCode = _mm256_set1_epi8(MapCodec::OBSTACLE);
+        const __m256i chargerCode = _mm256_set1_epi8(MapCodec::CHARGER);
+        const __m256i unvisitedCode = _mm256_set1_epi8(MapCodec::UNVISITED);
+        const __m256i invalidCode = _mm256_set1_epi8(static_cast<char>(MapCodec::INVALID));
+
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i digit = _mm256_sub_epi8(c, zeroChar);
+            __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+            __m256i isObstacle = _mm256_cmpeq_epi8(c, obstacleChar);
+            __m256i isCharger = _mm256_cmpeq_epi8(c, chargerChar);
+            __m256i isUnvisited = _mm256_and_si256(_mm256_cmpeq_epi8(c, unvisitedChar), unvisitedAllowed);
+            __m256i valid = _mm256_or_si256(_mm256_or_si256(isDigit, isObstacle), _mm256_or_si256(isCharger, isUnvisited));
+
+            __m256i code = _mm256_and_si256(isDigit, digit);
+            code = _mm256_or_si256(code, _mm256_and_si256(isObstacle, obstacleCode));
+            code = _mm256_or_si256(code, _mm256_and_si256(isCharger, chargerCode));
+            code = _mm256_or_si256(code, _mm256_and_si256(isUnvisited, unvisitedCode));
+            code = _mm256_or_si256(code, _mm256_andnot_si256(valid, invalidCode));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + i), code);
+
+            unsigned invalidMask = ~static_cast<unsigned>(_mm256_movemask_epi8(valid));
+            unsigned chargerMask = static_cast<unsigned>(_mm256_movemask_epi8(isCharger));
+            if (accountBlock(i, invalidMask, chargerMask, result)) {
+                return result;
+            }
+        }
+        return decodeScalarFrom(src, i, count, codes, allowUnvisited, result);
+    }
+
+    MAP_CODEC_TARGET("avx2")
+    void encodeAvx2(const uint8_t* codes, size_t count, char* dst) {
+        // vpshufb looks codes up in a 16-entry table; INVALID is first clamped to 15 ('?')
+        const __m256i table = _mm256_setr_epi8(
+            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'P', 'B', '?', '?', '?', '?',
+            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'P', 'B', '?', '?', '?', '?');
+        const __m256i maxIndex = _mm256_set1_epi8(15);
+
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m256i code = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i));
+            __m256i out = _mm256_shuffle_epi8(table, _mm256_min_epu8(code, maxIndex));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+        }
+        encodeScalarFrom(codes, i, count, dst);
+    }
+
+    bool cpuHasAvx2() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        bool osUsesXsave = (info[2] & (1 << 27)) != 0;
+        bool hasAvx = (info[2] & (1 << 28)) != 0;
+        if (!osUsesXsave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    using DecodeFn = MapCodec::DecodeResult(*)(const char*, size_t, uint8_t*, bool);
+    using EncodeFn = void(*)(const uint8_t*, size_t, char*);
+
+    struct Dispatch {
+        MapCodec::Kernel kernel;
+        DecodeFn decode;
+        EncodeFn encode;
+    };
+
+    Dispatch dispatchFor(MapCodec::Kernel kernel) {
+        switch (kernel) {
+#ifdef MAP_CODEC_X86
+        case MapCodec::Kernel::avx2:
+            return { kernel, decodeAvx2, encodeAvx2 };
+        case MapCodec::Kernel::sse2:
+            return { kernel, decodeSse2, encodeSse2 };
+#endif
+        default:
+            return { MapCodec::Kernel::scalar, decodeScalar, encodeScalar };
+        }
+    }
+
+    Dispatch detectBestKernel() {
+        if (MapCodec::isKernelSupported(MapCodec::Kernel::avx2)) {
+            return dispatchFor(MapCodec::Kernel::avx2);
+        }
+        if (MapCodec::isKernelSupported(MapCodec::Kernel::sse2)) {
+            return dispatchFor(MapCodec::Kernel::sse2);
+        }
+        return dispatchFor(MapCodec::Kernel::scalar);
+    }
+
+    Dispatch& currentDispatch() {
+        static Dispatch dispatch = detectBestKernel();
+        return dispatch;
+    }
+}
+
+namespace MapCodec {
+    DecodeResult decodeRow(const char* src, size_t count, uint8_t* codes, bool allowUnvisited) {
+        return currentDispatch().decode(src, count, codes, allowUnvisited);
+    }
+
+    void encodeRow(const uint8_t* codes, size_t count, char* dst) {
+        currentDispatch().encode(codes, count, dst);
+    }
+
+    Kernel activeKernel() {
+        return currentDispatch().kernel;
+    }
+
+    bool isKernelSupported(Kernel kernel) {
+        switch (kernel) {
+#ifdef MAP_CODEC_X86
+        case Kernel::avx2:
+            return cpuHasAvx2();
+        case Kernel::sse2:
+            return true;
+#endif
+        case Kernel::scalar:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void setKernel(Kernel kernel) {
+        if (isKernelSupported(kernel)) {
+            currentDispatch() = dispatchFor(kernel);
+        }
+    }
+
+    const char* kernelName(Kernel kernel) {
+        switch (kernel) {
+        case Kernel::avx2:
+            return "avx2";
+        case Kernel::sse2:
+            return "sse2";
+        default:
+            return "scalar";
+        }
+    }
+}
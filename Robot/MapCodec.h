@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Wektorowe kodowanie i dekodowanie wierszy mapy tekstowej.
+// Każdy znak mapy odpowiada jednemu bajtowi kodu:
+// 0-9 - podłoga z danym poziomem brudu, dalej przeszkoda, ładowarka, nieodwiedzony.
+namespace MapCodec {
+    constexpr uint8_t OBSTACLE = 10;
+    constexpr uint8_t CHARGER = 11;
+    constexpr uint8_t UNVISITED = 12;
+    constexpr uint8_t INVALID = 0xFF;
+
+    enum class Kernel {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    struct DecodeResult {
+        size_t invalidPos;      // Index of the first invalid character, count if none
+        size_t chargerCount;    // Number of 'B' characters before invalidPos
+        size_t firstCharger;    // Index of the first 'B', count if none
+    };
+
+    // Classifies count characters into codes; stops at the first invalid character
+    DecodeResult decodeRow(const char* src, size_t count, uint8_t* codes, bool allowUnvisited);
+    // Writes the map character of every code; INVALID is written as '?'
+    void encodeRow(const uint8_t* codes, size_t count, char* dst);
+
+    // Kernel picked at runtime from the CPU features; can be overridden for benchmarks
+    Kernel activeKernel();
+    bool isKernelSupported(Kernel kernel);
+    void setKernel(Kernel kernel);
+    const char* kernelName(Kernel kernel);
+}
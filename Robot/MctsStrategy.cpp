@@ -0,0 +1,255 @@
+#include "MctsStrategy.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include "DistanceMatrix.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t NODE_LIMIT = 1 << 15;      // Per tree; later leaves are only rolled out
+    constexpr uint32_t RANDOM_ROLLOUT_PERCENT = 25;
+
+    // Model jednej decyzji, tylko do odczytu dla wszystkich wątków
+    struct Problem {
+        size_t count = 0;
+        size_t horizon = 0;
+        uint32_t fromRobot[MctsStrategy::MAX_CANDIDATES] = {};
+        uint8_t dirt[MctsStrategy::MAX_CANDIDATES] = {};
+        std::vector<double> discount;   // Weight of dirt cleaned after the given number of steps
+        const DistanceMatrix* between = nullptr;
+    };
+
+    struct State {
+        size_t location = SIZE_MAX;     // Candidate the robot stands on, SIZE_MAX at the start
+        uint64_t cleaned = 0;
+        size_t steps = 0;
+        double dirt = 0;                // Discounted
+    };
+
+    struct Node {
+        uint32_t firstChild = 0;
+        uint8_t childCount = 0;
+        uint8_t candidate = 0;
+        bool expanded = false;
+        uint32_t visits = 0;
+        double value = 0;
+    };
+
+    // Steps to reach and clean the candidate, 0 when it can't be done within the horizon
+    size_t cost(const Problem& problem, const State& state, size_t candidate) {
+        if ((state.cleaned >> candidate) & 1u) {
+            return 0;
+        }
+        const uint32_t distance = state.location == SIZE_MAX ? problem.fromRobot[candidate]
+            : problem.between->at(state.location, candidate);
+        if (distance == DistanceMatrix::UNREACHABLE || state.steps + distance + 1 > problem.horizon) {
+            return 0;
+        }
+        return distance + 1;
+    }
+
+    void apply(const Problem& problem, State& state, size_t candidate, size_t steps) {
+        state.location = candidate;
+        state.cleaned |= uint64_t{ 1 } << candidate;
+        state.steps += steps;
+        state.dirt += problem.dirt[candidate] * problem.discount[state.steps];
+    }
+
+    // Dokończenie przebiegu: najczęściej najlepszy stosunek brudu do kroków, czasem losowy kandydat
+    void rollout(const Problem& problem, State& state, std::mt19937_64& rng) {
+        size_t feasible[MctsStrategy::MAX_CANDIDATES];
+        for (;;) {
+            size_t count = 0;
+            size_t best = SIZE_MAX;
+            size_t bestSteps = 0;
+            for (size_t c = 0; c < problem.count; ++c) {
+                const size_t steps = cost(problem, state, c);
+                if (steps == 0) {
+                    continue;
+                }
+                feasible[count++] = c;
+                if (best == SIZE_MAX || problem.dirt[c] * bestSteps > problem.dirt[best] * steps) {
+                    best = c;
+                    bestSteps = steps;
+                }
+            }
+            if (count == 0) {
+                return;
+            }
+            if (rng() % 100 < RANDOM_ROLLOUT_PERCENT) {
+                best = feasible[rng() % count];
+                bestSteps = cost(problem, state, best);
+            }
+            apply(problem, state, best, bestSteps);
+        }
+    }
+
+    // Jedno drzewo; visits i value dzieci korzenia są dopisywane do tablic indeksowanych kandydatem
+    void searchTree(const Problem& problem, const MctsStrategy::Options& options, uint64_t seed,
+        Clock::time_point deadline, std::vector<uint32_t>& rootVisits, std::vector<double>& rootValue) {
+        std::mt19937_64 rng(seed);
+        std::vector<Node> nodes;
+        nodes.reserve(NODE_LIMIT);
+        nodes.emplace_back();
+        uint32_t pathNodes[MctsStrategy::MAX_CANDIDATES + 1];
+        // Nagrody są skalowane do zakresu widzianego w tym drzewie, inaczej stała eksploracji
+        // zależałaby od gęstości brudu na mapie
+        double minReward = std::numeric_limits<double>::max();
+        double maxReward = 0.0;
+
+        for (size_t iteration = 0;; ++iteration) {
+            if (options.maxIterations != 0 && iteration >= options.maxIterations) {
+                break;
+            }
+            // Każde dziecko korzenia dostaje co najmniej jeden przebieg
+            const bool rootVisited = nodes[0].expanded && iteration > nodes[0].childCount;
+            if (rootVisited && iteration % 32 == 0 && Clock::now() >= deadline) {
+                break;
+            }
+
+            State state;
+            size_t depth = 0;
+            uint32_t current = 0;
+            pathNodes[depth++] = current;
+            while (nodes[current].expanded && nodes[current].childCount > 0) {
+                const Node& parent = nodes[current];
+                const double logVisits = std::log(static_cast<double>(std::max<uint32_t>(parent.visits, 1)));
+                const double range = maxReward > minReward ? maxReward - minReward : 1.0;
+                uint32_t chosen = parent.firstChild;
+                double chosenScore = -1;
+                for (uint32_t child = parent.firstChild; child < parent.firstChild + parent.childCount; ++child) {
+                    if (nodes[child].visits == 0) {
+                        chosen = child;
+                        break;
+                    }
+                    const double score = (nodes[child].value / nodes[child].visits - minReward) / range
+                        + options.exploration * std::sqrt(logVisits / nodes[child].visits);
+                    if (score > chosenScore) {
+                        chosen = child;
+                        chosenScore = score;
+                    }
+                }
+                apply(problem, state, nodes[chosen].candidate, cost(problem, state, nodes[chosen].candidate));
+                current = chosen;
+                pathNodes[depth++] = current;
+            }
+
+            // Rozwinięcie liścia o wszystkich kandydatów osiągalnych w horyzoncie
+            if (!nodes[current].expanded && nodes.size() + problem.count <= NODE_LIMIT) {
+                const uint32_t firstChild = static_cast<uint32_t>(nodes.size());
+                for (size_t c = 0; c < problem.count; ++c) {
+                    if (cost(problem, state, c) != 0) {
+                        Node child;
+                        child.candidate = static_cast<uint8_t>(c);
+                        nodes.push_back(child);
+                    }
+                }
+                nodes[current].expanded = true;
+                nodes[current].firstChild = firstChild;
+                nodes[current].childCount = static_cast<uint8_t>(nodes.size() - firstChild);
+                if (nodes[current].childCount > 0) {
+                    current = firstChild;
+                    apply(problem, state, nodes[current].candidate, cost(problem, state, nodes[current].candidate));
+                    pathNodes[depth++] = current;
+                }
+            }
+
+            rollout(problem, state, rng);
+            const double result = state.dirt;
+            minReward = std::min(minReward, result);
+            maxReward = std::max(maxReward, result);
+            for (size_t i = 0; i < depth; ++i) {
+                nodes[pathNodes[i]].visits++;
+                nodes[pathNodes[i]].value += result;
+            }
+        }
+
+        const Node& root = nodes[0];
+        for (uint32_t child = root.firstChild; child < root.firstChild + root.childCount; ++child) {
+            rootVisits[nodes[child].candidate] += nodes[child].visits;
+            rootValue[nodes[child].candidate] += nodes[child].value;
+        }
+    }
+}
+
+MctsStrategy::MctsStrategy(const Options& searchOptions) : options(searchOptions) {
+    options.candidates = std::min(options.candidates, MAX_CANDIDATES);
+}
+
+bool MctsStrategy::createPathBestOrder(Robot& robot) const {
+    // Budżet obejmuje całą decyzję: szukanie kandydatów i macierz odległości też się liczą
+    const Clock::time_point deadline = Clock::now()
+        + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(options.budgetMs));
+    const Map& map = memory(robot);
+    SearchTree& tree = threadSearchTree();
+    std::vector<size_t> tiles;
+    Problem problem;
+    problem.horizon = options.horizon;
+
+    searchFrom(robot, tree, [&](size_t tile, size_t distance) {
+        const Floor* floor = map.getTile(tile)->asFloor();
+        if (distance != 0 && floor && floor->isDirty() && !isClaimed(robot, tile)) {
+            problem.fromRobot[tiles.size()] = static_cast<uint32_t>(distance);
+            problem.dirt[tiles.size()] = static_cast<uint8_t>(floor->getCleanliness());
+            tiles.push_back(tile);
+        }
+        return tiles.size() >= options.candidates;
+    });
+    if (tiles.empty()) {
+        return false;
+    }
+
+    size_t best = 0;
+    if (tiles.size() > 1) {
+        const DistanceMatrix between = DistanceMatrix::compute(map, tiles, tiles);
+        problem.count = tiles.size();
+        problem.between = &between;
+        // Najbliższy kandydat musi zmieścić się w horyzoncie, inaczej drzewo byłoby puste
+        problem.horizon = std::max<size_t>(problem.horizon, problem.fromRobot[0] + 1);
+        problem.discount.resize(problem.horizon + 1);
+        for (size_t steps = 0; steps <= problem.horizon; ++steps) {
+            problem.discount[steps] = std::pow(options.discount, static_cast<double>(steps));
+        }
+
+        const unsigned threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        const uint64_t decision = decisions.fetch_add(1);
+        std::vector<std::vector<uint32_t>> visits(threads, std::vector<uint32_t>(tiles.size()));
+        std::vector<std::vector<double>> values(threads, std::vector<double>(tiles.size()));
+        pool.run(threads, [&](unsigned t) {
+            searchTree(problem, options, options.seed + decision * threads + t, deadline, visits[t], values[t]);
+        });
+
+        // Najczęściej odwiedzany kandydat, przy remisie lepsza średnia
+        uint32_t bestVisits = 0;
+        double bestValue = 0;
+        for (size_t c = 0; c < tiles.size(); ++c) {
+            uint32_t total = 0;
+            double value = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                total += visits[t][c];
+                value += values[t][c];
+            }
+            if (total > bestVisits || (total == bestVisits && total != 0 && value > bestValue)) {
+                best = c;
+                bestVisits = total;
+                bestValue = value;
+            }
+        }
+    }
+    setPath(robot, tree, tiles[best]);
+    return true;
+}
+
+std::optional<RobotAction> MctsStrategy::plan(Robot& robot) const {
+    if (hasPath(robot) || createPathBestOrder(robot) || createPathToVisit(robot) || createPathToCharger(robot)) {
+        return RobotAction::clean;
+    }
+    if (createPathUnvisited(robot)) {
+        return RobotAction::explore;
+    }
+    return std::nullopt;
+}
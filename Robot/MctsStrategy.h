@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CleaningStrategy.h"
+#include "WorkerPool.h"
+
+// Monte Carlo tree search po kolejności sprzątania najbliższych brudnych kafelków.
+// Ruchem w drzewie jest dojazd do jednego z kandydatów i jego sprzątnięcie; odległości
+// między kandydatami są liczone raz na decyzję, więc symulacja nie przegląda mapy i nie alokuje.
+// Nagrodą przebiegu jest sprzątnięty brud dyskontowany liczbą kroków, więc wygrywa najwięcej
+// sprzątania na krok. Każdy wątek buduje własne drzewo (równoległość w korzeniu), wyniki korzeni są sumowane.
+class MctsStrategy : public CleaningStrategy {
+public:
+    struct Options {
+        double budgetMs = 2.0;          // Time for one decision
+        unsigned threads = 0;           // Trees searched in parallel, 0 = hardware concurrency
+        size_t candidates = 24;         // Nearest dirty tiles taken into account, at most MAX_CANDIDATES
+        size_t horizon = 200;           // Steps simulated from the robot's position
+        size_t maxIterations = 0;       // Iterations per tree, 0 = limited by the budget only
+        double exploration = 0.7;       // UCB1 constant
+        double discount = 0.8;          // Per step; dirt cleaned sooner is worth more
+        uint64_t seed = 1;
+    };
+
+    static constexpr size_t MAX_CANDIDATES = 64;
+
+private:
+    Options options;
+    mutable std::atomic<uint64_t> decisions{ 0 };  // Each decision uses different random numbers
+    mutable WorkerPool pool;                        // Threads kept between decisions
+
+    bool createPathBestOrder(Robot& robot) const;
+
+public:
+    MctsStrategy() = default;
+    explicit MctsStrategy(const Options& searchOptions);
+
+    const char* getName() const noexcept override { return "mcts"; }
+    std::optional<RobotAction> plan(Robot& robot) const override;
+    const Options& getOptions() const noexcept { return options; }
+};
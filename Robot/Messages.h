@@ -21,8 +21,15 @@ namespace Messages {
     const std::string ENTER_TARGET_TILE_MOVE_PROMPT = "Enter target Tile ID for robot to move: ";
     const std::string ENTER_TILE_CLEAN_PROMPT = "Enter Tile ID for robot to clean: ";
     const std::string ENTER_CLEANING_RADIUS_PROMPT = "Enter cleaning radius: ";
+    const std::string ENTER_REGION_LEFT_PROMPT = "Enter left column of the area: ";
+    const std::string ENTER_REGION_TOP_PROMPT = "Enter top row of the area: ";
+    const std::string ENTER_REGION_RIGHT_PROMPT = "Enter right column of the area: ";
+    const std::string ENTER_REGION_BOTTOM_PROMPT = "Enter bottom row of the area: ";
+    const std::string ENTER_ZONE_NAME_PROMPT = "Enter zone name: ";
+    const std::string ENTER_LANDMARK_COUNT_PROMPT = "Enter number of landmarks (each takes 2 bytes per tile): ";
+    const std::string ENTER_FLEET_SIZE_PROMPT = "Enter number of robots (copies of the current robot, extra ones start at the charger): ";
     const std::string ENTER_SIM_STEPS_PROMPT = "Enter number of simulation steps to run: ";
-    const std::string ENTER_SAVE_FILENAME_PROMPT = "Enter filename to save simulation (e.g., my_sim.txt): ";
+    const std::string ENTER_SAVE_FILENAME_PROMPT = "Enter filename to save simulation (e.g., my_sim.txt, or my_sim.rle for run-length format): ";
     const std::string ENTER_LOAD_FILENAME_PROMPT = "Enter filename to load simulation from (e.g., other_sim.txt): ";
     const std::string DO_YOU_WANT_SAVE_LOGS_PROMPT = "Do you want to save the simulation log to a file? (y/N): ";
     const std::string ENTER_LOG_FILENAME_PROMPT = "Enter log file name (e.g., simulation_log.txt): ";
@@ -67,6 +74,10 @@ namespace Messages {
     const std::string MAIN_MENU_OPTION_9 = "9. Save Current Simulation State\n";
     const std::string MAIN_MENU_OPTION_10 = "10. Load Simulation from File\n";
     const std::string MAIN_MENU_OPTION_11 = "11. Order Robot to Clean Efficiently\n";
+    const std::string MAIN_MENU_OPTION_12 = "12. Order Robot to Clean an Area\n";
+    const std::string MAIN_MENU_OPTION_13 = "13. Order Robot to Clean a Zone\n";
+    const std::string MAIN_MENU_OPTION_14 = "14. Run a Fleet of Robots\n";
+    const std::string MAIN_MENU_OPTION_15 = "15. Precompute Landmarks for Faster Routes\n";
     const std::string MAIN_MENU_OPTION_0 = "0. Exit Simulation\n";
 
     // --- Map & Robot Related Messages ---
@@ -99,6 +110,23 @@ namespace Messages {
     const std::string ROBOT_ORDER_CLEAN_FAIL = "Failed to order robot to clean Tile ID: ";
     const std::string ROBOT_ORDER_CLEAN_FAIL_CONT = ". Invalid target or already clean.\n";
     const std::string ROBOT_ORDER_CLEAN_EFFICIENTLY_SUCCESS = "Robot ordered to clean efficiently (based on current position).\n";
+    const std::string ROBOT_ORDER_CLEAN_AREA_SUCCESS = "Robot ordered to clean area with ";
+    const std::string ROBOT_ORDER_CLEAN_AREA_SUCCESS_CONT = " tiles to check.\n";
+    const std::string ROBOT_ORDER_CLEAN_AREA_FAIL = "Failed to order robot to clean the area. No known reachable floor inside.\n";
+    const std::string NO_ZONES_DEFINED = "No zones defined. Put them in a .zones file next to the simulation file.\n";
+    const std::string AVAILABLE_ZONES = "Available zones:";
+    const std::string UNKNOWN_ZONE_ERROR = "Unknown zone: ";
+    const std::string ZONES_LOADED = "Zones loaded: ";
+    const std::string ERROR_LOADING_ZONES = "Error loading zones: ";
+    const std::string FLEET_SIZE_ERROR = "Fleet needs at least one robot.\n";
+    const std::string FLEET_FINISHED = "Fleet finished after ";
+    const std::string FLEET_FINISHED_CONT = " ticks. Robots still active: ";
+    const std::string FLEET_METRICS_HEADER = "Robot  Position  Moves  Cleans  Waits  Sidesteps  Dirt cleaned  Error\n";
+    const std::string LANDMARKS_BUILT = "Landmarks computed: ";
+    const std::string LANDMARKS_BUILT_CONT = ". They are saved next to the simulation file.\n";
+    const std::string LANDMARKS_LOADED = "Landmarks loaded: ";
+    const std::string LANDMARKS_STALE = "Landmark table does not match the map and was ignored.\n";
+    const std::string ERROR_LOADING_LANDMARKS = "Error loading landmarks: ";
     const std::string ROBOT_MEMORY_RESET_SUCCESS = "Robot's memory successfully reset.\n";
     const std::string SIMULATION_SAVE_ERROR_FILE_OPEN = "Error: Could not open file for saving: ";
     const std::string SIMULATION_SAVE_ERROR_DURING_SAVE = "Error during saving: ";
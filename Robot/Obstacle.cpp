@@ -1,6 +1,6 @@
 #include "Obstacle.h"
 
-Obstacle::Obstacle(size_t id) : Tile(id) {}
+Obstacle::Obstacle() : Tile(TileKind::obstacle) {}
 
 std::unique_ptr<Tile> Obstacle::clone() const {
     return std::make_unique<Obstacle>(*this);
@@ -3,7 +3,7 @@
 
 class Obstacle : public Tile {
 public:
-    Obstacle(size_t id = 0);
+    Obstacle();
 
     std::unique_ptr<Tile> clone() const override;
     bool isMoveValid() const override;
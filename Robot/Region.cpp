@@ -0,0 +1,236 @@
+#include "Region.h"
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    int64_t floorDiv(int64_t num, int64_t den) {
+        int64_t q = num / den;
+        return (num % den != 0 && (num < 0) != (den < 0)) ? q - 1 : q;
+    }
+
+    int64_t ceilDiv(int64_t num, int64_t den) {
+        return -floorDiv(-num, den);
+    }
+
+    // Przecięcie krawędzi wielokąta z wierszem: dokładna pozycja do sortowania i najbliższe kolumny
+    struct Crossing {
+        double x;
+        int64_t floorX;
+        int64_t ceilX;
+    };
+}
+
+Region::Region(Shape regionShape, std::vector<RegionPoint> regionVertices)
+    : shape(regionShape), vertices(std::move(regionVertices)) {
+    minX = maxX = vertices.front().x;
+    minY = maxY = vertices.front().y;
+    for (const RegionPoint& v : vertices) {
+        minX = std::min(minX, v.x);
+        maxX = std::max(maxX, v.x);
+        minY = std::min(minY, v.y);
+        maxY = std::max(maxY, v.y);
+    }
+}
+
+Region Region::rect(int64_t left, int64_t top, int64_t right, int64_t bottom) {
+    return Region(Shape::rect, { { std::min(left, right), std::min(top, bottom) },
+        { std::max(left, right), std::max(top, bottom) } });
+}
+
+Region Region::polygon(std::vector<RegionPoint> polygonVertices) {
+    if (polygonVertices.size() < 3) {
+        throw std::runtime_error("Polygon needs at least 3 vertices.");
+    }
+    return Region(Shape::polygon, std::move(polygonVertices));
+}
+
+void Region::rowSpans(int64_t row, std::vector<Span>& out) const {
+    out.clear();
+    if (row < minY || row > maxY) {
+        return;
+    }
+    if (shape == Shape::rect) {
+        out.push_back({ minX, maxX });
+        return;
+    }
+
+    std::vector<Crossing> crossings;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        RegionPoint a = vertices[i];
+        RegionPoint b = vertices[(i + 1) % vertices.size()];
+        if (a.y == b.y) {
+            // Poziomy brzeg leżący na tym wierszu
+            if (a.y == row) {
+                out.push_back({ std::min(a.x, b.x), std::max(a.x, b.x) });
+            }
+            continue;
+        }
+        if (a.y > b.y) {
+            std::swap(a, b);
+        }
+        if (row < a.y || row > b.y) {
+            continue;
+        }
+
+        const int64_t num = (row - a.y) * (b.x - a.x);
+        const int64_t dy = b.y - a.y;
+        const Crossing crossing = { static_cast<double>(a.x) + static_cast<double>(num) / static_cast<double>(dy),
+            a.x + floorDiv(num, dy), a.x + ceilDiv(num, dy) };
+        // Środek kafelka na brzegu
+        if (crossing.floorX == crossing.ceilX) {
+            out.push_back({ crossing.floorX, crossing.floorX });
+        }
+        // Górny koniec krawędzi liczony, dolny nie - wierzchołki nie dublują przecięć
+        if (row < b.y) {
+            crossings.push_back(crossing);
+        }
+    }
+
+    std::sort(crossings.begin(), crossings.end(), [](const Crossing& l, const Crossing& r) { return l.x < r.x; });
+    for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+        if (crossings[i].ceilX <= crossings[i + 1].floorX) {
+            out.push_back({ crossings[i].ceilX, crossings[i + 1].floorX });
+        }
+    }
+
+    // Scalanie nakładających się i sąsiadujących odcinków
+    std::sort(out.begin(), out.end());
+    size_t merged = 0;
+    for (size_t i = 1; i < out.size(); ++i) {
+        if (out[i].first <= out[merged].second + 1) {
+            out[merged].second = std::max(out[merged].second, out[i].second);
+        }
+        else {
+            out[++merged] = out[i];
+        }
+    }
+    if (!out.empty()) {
+        out.resize(merged + 1);
+    }
+}
+
+bool Region::contains(int64_t x, int64_t y) const {
+    std::vector<Span> spans;
+    rowSpans(y, spans);
+    for (const Span& span : spans) {
+        if (span.first <= x && x <= span.second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t Region::tileCount(size_t width, size_t height) const {
+    size_t count = 0;
+    forEachSpan(width, height, [&](size_t, size_t first, size_t last) {
+        count += last - first + 1;
+    });
+    return count;
+}
+
+std::filesystem::path ZoneSet::sidecarPath(const std::filesystem::path& mapPath) {
+    std::filesystem::path path = mapPath;
+    path += ".zones";
+    return path;
+}
+
+void ZoneSet::load(std::istream& in) {
+    std::vector<Zone> loaded;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        std::istringstream iss(line);
+        std::string name;
+        if (!(iss >> name) || name[0] == '#') {
+            continue;
+        }
+        const std::string where = "Invalid zone at line " + std::to_string(lineNumber) + ": ";
+
+        std::string shape;
+        iss >> shape;
+        std::vector<int64_t> coords;
+        int64_t value;
+        while (iss >> value) {
+            coords.push_back(value);
+        }
+        if (!iss.eof()) {
+            throw std::runtime_error(where + "coordinates must be integers.");
+        }
+
+        Region region;
+        if (shape == "rect") {
+            if (coords.size() != 4) {
+                throw std::runtime_error(where + "rect needs 4 coordinates.");
+            }
+            region = Region::rect(coords[0], coords[1], coords[2], coords[3]);
+        }
+        else if (shape == "polygon") {
+            if (coords.size() < 6 || coords.size() % 2 != 0) {
+                throw std::runtime_error(where + "polygon needs at least 3 coordinate pairs.");
+            }
+            std::vector<RegionPoint> points;
+            for (size_t i = 0; i < coords.size(); i += 2) {
+                points.push_back({ coords[i], coords[i + 1] });
+            }
+            region = Region::polygon(std::move(points));
+        }
+        else {
+            throw std::runtime_error(where + "unknown shape '" + shape + "'.");
+        }
+
+        for (const Zone& zone : loaded) {
+            if (zone.name == name) {
+                throw std::runtime_error(where + "duplicate zone name '" + name + "'.");
+            }
+        }
+        loaded.push_back({ name, std::move(region) });
+    }
+    zones = std::move(loaded);
+}
+
+void ZoneSet::save(std::ostream& out) const {
+    for (const Zone& zone : zones) {
+        const Region& region = zone.region;
+        out << zone.name;
+        if (region.getShape() == Region::Shape::rect) {
+            out << " rect " << region.left() << " " << region.top() << " " << region.right() << " " << region.bottom();
+        }
+        else {
+            out << " polygon";
+            for (const RegionPoint& v : region.getVertices()) {
+                out << " " << v.x << " " << v.y;
+            }
+        }
+        out << "\n";
+    }
+}
+
+void ZoneSet::set(const std::string& name, const Region& region) {
+    for (Zone& zone : zones) {
+        if (zone.name == name) {
+            zone.region = region;
+            return;
+        }
+    }
+    zones.push_back({ name, region });
+}
+
+bool ZoneSet::remove(const std::string& name) {
+    for (auto it = zones.begin(); it != zones.end(); ++it) {
+        if (it->name == name) {
+            zones.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+const Region* ZoneSet::find(const std::string& name) const {
+    for (const Zone& zone : zones) {
+        if (zone.name == name) {
+            return &zone.region;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Punkt obszaru we współrzędnych kafelków (kolumna, wiersz); może leżeć poza mapą
+struct RegionPoint {
+    int64_t x;
+    int64_t y;
+
+    bool operator==(const RegionPoint& other) const noexcept { return x == other.x && y == other.y; }
+};
+
+// Obszar mapy: prostokąt lub wielokąt. Kafelek należy do wielokąta,
+// gdy jego środek leży wewnątrz lub na brzegu.
+class Region {
+public:
+    enum class Shape {
+        rect,
+        polygon
+    };
+
+    // Inclusive columns of one row that lie inside the region
+    using Span = std::pair<int64_t, int64_t>;
+
+private:
+    Shape shape = Shape::rect;
+    std::vector<RegionPoint> vertices; // Rect: top-left and bottom-right corner
+    int64_t minX = 0, minY = 0, maxX = -1, maxY = -1;
+
+    Region(Shape regionShape, std::vector<RegionPoint> regionVertices);
+
+public:
+    Region() = default;
+
+    // Inclusive corners in any order
+    static Region rect(int64_t left, int64_t top, int64_t right, int64_t bottom);
+    // At least three vertices, edges connect consecutive vertices and the last with the first
+    static Region polygon(std::vector<RegionPoint> polygonVertices);
+
+    Shape getShape() const noexcept { return shape; }
+    const std::vector<RegionPoint>& getVertices() const noexcept { return vertices; }
+    int64_t top() const noexcept { return minY; }
+    int64_t bottom() const noexcept { return maxY; }
+    int64_t left() const noexcept { return minX; }
+    int64_t right() const noexcept { return maxX; }
+
+    // Sorted, non-overlapping spans of the given row (not clipped to any map)
+    void rowSpans(int64_t row, std::vector<Span>& out) const;
+    bool contains(int64_t x, int64_t y) const;
+
+    // Calls fn(row, firstColumn, lastColumn) for every span clipped to a width x height map;
+    // only the rows and columns of the region are visited
+    template <typename Fn>
+    void forEachSpan(size_t width, size_t height, Fn&& fn) const {
+        if (width == 0 || height == 0 || maxX < 0 || maxY < 0) {
+            return;
+        }
+        const int64_t lastColumn = static_cast<int64_t>(width) - 1;
+        const int64_t firstRow = std::max<int64_t>(minY, 0);
+        const int64_t lastRow = std::min<int64_t>(maxY, static_cast<int64_t>(height) - 1);
+        std::vector<Span> spans;
+        for (int64_t row = firstRow; row <= lastRow; ++row) {
+            rowSpans(row, spans);
+            for (const Span& span : spans) {
+                const int64_t first = std::max<int64_t>(span.first, 0);
+                const int64_t last = std::min(span.second, lastColumn);
+                if (first <= last) {
+                    fn(static_cast<size_t>(row), static_cast<size_t>(first), static_cast<size_t>(last));
+                }
+            }
+        }
+    }
+    // Number of map tiles inside the region
+    size_t tileCount(size_t width, size_t height) const;
+
+    bool operator==(const Region& other) const noexcept { return shape == other.shape && vertices == other.vertices; }
+};
+
+// Nazwane strefy sprzątania zapisywane w pliku obok mapy (<mapa>.zones).
+// Jedna strefa na linię: "nazwa rect x1 y1 x2 y2" albo "nazwa polygon x1 y1 x2 y2 x3 y3 ...",
+// linie puste i zaczynające się od '#' są pomijane.
+class ZoneSet {
+public:
+    struct Zone {
+        std::string name;
+        Region region;
+    };
+
+private:
+    std::vector<Zone> zones;
+
+public:
+    static std::filesystem::path sidecarPath(const std::filesystem::path& mapPath);
+
+    // Replaces all zones; throws std::runtime_error on a malformed line
+    void load(std::istream& in);
+    void save(std::ostream& out) const;
+
+    // Adds the zone or replaces the region of a zone with the same name
+    void set(const std::string& name, const Region& region);
+    bool remove(const std::string& name);
+    void clear() noexcept { zones.clear(); }
+    // nullptr if there is no zone with that name
+    const Region* find(const std::string& name) const;
+
+    size_t size() const noexcept { return zones.size(); }
+    bool empty() const noexcept { return zones.empty(); }
+    const std::vector<Zone>& getZones() const noexcept { return zones; }
+};
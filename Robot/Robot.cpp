@@ -1,40 +1,65 @@
 #include "Robot.h"
+#include "GreedyStrategy.h"
+#include "CoveragePlanner.h"
+#include <algorithm>
 #include <limits>
 #include <cmath>
 
-Direction Robot::move() {
-	if (path.empty()) {
-		return Direction::none;
+namespace {
+	std::shared_ptr<const CleaningStrategy> defaultStrategy() {
+		static const std::shared_ptr<const CleaningStrategy> greedy = std::make_shared<GreedyStrategy>();
+		return greedy;
 	}
-	size_t nextTarget = path.front();
-	path.pop();
 
-	for (Direction dir : {Direction::up, Direction::down, Direction::left, Direction::right}) {
-		auto neighbour = map.getIndex(position_, dir);
-		if (neighbour.has_value() && neighbour == nextTarget && map.canMoveOn(nextTarget)) {
+	// Bufory wyszukiwań tras wspólne dla kolejnych wywołań w wątku; kafelek należy do bieżącego
+	// wyszukiwania, gdy jego znacznik równa się numerowi wyszukiwania
+	struct PathSearch {
+		std::vector<uint32_t> stamp;
+		std::vector<uint32_t> cost;
+		std::vector<TileIndex> parent;
+		std::vector<std::pair<uint64_t, TileIndex>> open;	// A*: (priority, tile), min-heap
+		std::vector<TileIndex> queue;						// BFS
+		uint32_t search = 0;
+
+		// Number of a new search over size tiles
+		uint32_t begin(size_t size) {
+			if (stamp.size() != size || search == UINT32_MAX) {
+				stamp.assign(size, 0);
+				cost.resize(size);
+				parent.resize(size);
+				search = 0;
+			}
+			return ++search;
+		}
+	};
+	thread_local PathSearch pathSearch;
+}
+
+RobotStep Robot::move() {
+	while (!path.empty()) {
+		size_t nextTarget = path.front();
+		Direction dir = path.frontDirection();
+		path.pop();
+
+		if (map.canMoveOn(nextTarget)) {
 			position_ = nextTarget;
-			return dir;
+			return { RobotAction::move, dir };
 		}
-		else if (neighbour == nextTarget) {
-			// Calculate new route
-			if (createPath(path.back())) {
-				return move();
-			}
-			else {
-				break;
-			}
+
+		// Calculate new route; its first step is always walkable
+		if (!createPath(path.empty() ? nextTarget : path.back())) {
+			// Can't reach move target
+			clearMoveTargets();
+			return { RobotAction::move, Direction::none, RobotError::unreachableTile, nextTarget };
 		}
 	}
-
-	// Can't reach move target
-	clearMoveTargets();
-	throw std::runtime_error("Can't reach tile ID: " + std::to_string(nextTarget) + "\n");
+	return { RobotAction::move, Direction::none };
 }
 
 void Robot::cleanTile() {
-	Tile* tile = map.getTile(position_);
+	const Tile* tile = getMemoryMap().getTile(position_);
 
-	if (auto floor = dynamic_cast<Floor*>(tile)) {
+	if (auto floor = tile->asFloor()) {
 		setEfficiency(floor->getCleanliness());
 	}
 	else {
@@ -43,211 +68,168 @@ void Robot::cleanTile() {
 }
 
 void Robot::clearMoveTargets() {
-	while (!path.empty()) {
-		path.pop();
+	path.reset(position_, map.getWidth(), map.getSize());
+	if (tilesToCheck.size() == map.getSize()) {
+		tilesToCheck.clear();
+	}
+	else {
+		tilesToCheck.assign(map.getSize());
 	}
-	tilesToCheck.assign(map.getSize(), false);
 }
 
-bool Robot::createPath(size_t targetId) {
-	while (!path.empty()) {
-		path.pop();
+bool Robot::canReach(size_t targetId) const {
+	if (targetId == position_) {
+		return true;
 	}
-	std::vector<bool> visited(map.getSize(), false);
-	std::vector<size_t> parent(map.getSize(), std::numeric_limits<size_t>::max());
-	std::queue<size_t> q;
-
-	visited[position_] = true;
-	q.push(position_);
-	while (!q.empty()) {
-		size_t current = q.front();
-		q.pop();
-		if (current == targetId) {
-			std::stack<size_t> tempStack;
-			for (size_t v = targetId; v != std::numeric_limits<size_t>::max(); v = parent[v]) {
-				tempStack.push(v);
-			}
-			tempStack.pop();
-			while (!tempStack.empty()) {
-				path.push(tempStack.top());
-				tempStack.pop();
-			}
+	const size_t component = map.getComponent(targetId);
+	if (component == Map::NO_COMPONENT) {
+		return false;
+	}
+	if (map.canMoveOn(position_)) {
+		return map.getComponent(position_) == component;
+	}
+	// Robot stoi na kafelku, po którym nie można jeździć - liczą się jego sąsiedzi
+	for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+		auto neighbour = map.getIndex(position_, dir);
+		if (neighbour.has_value() && map.getComponent(*neighbour) == component) {
 			return true;
 		}
-
-		std::vector<std::optional<size_t>> neighbours;
-		neighbours.push_back(map.getIndex(current, Direction::up));
-		neighbours.push_back(map.getIndex(current, Direction::down));
-		neighbours.push_back(map.getIndex(current, Direction::left));
-		neighbours.push_back(map.getIndex(current, Direction::right));
-
-		for (auto neighbour : neighbours) {
-			if (neighbour.has_value() && map.canMoveOn(*neighbour)) {
-				size_t idx = *neighbour;
-				if (!visited[idx]) {
-					visited[idx] = true;
-					parent[idx] = current;
-					q.push(idx);
-				}
-			}
-		}
 	}
 	return false;
 }
 
-bool Robot::createPathUnvisited() {
-	while (!path.empty()) {
-		path.pop();
-	}
-
-	std::vector<bool> visited(map.getSize(), false);
-	std::vector<size_t> parent(map.getSize(), std::numeric_limits<size_t>::max());
-	std::queue<size_t> q;
-
-	visited[position_] = true;
-	q.push(position_);
-	while (!q.empty()) {
-		size_t current = q.front();
-		const Tile* tile = map.getTile(current);
-		q.pop();
-		if (const auto unVisited = dynamic_cast<const UnVisited*>(tile)) {
-			std::stack<size_t> tempStack;
-			for (size_t v = current; v != std::numeric_limits<size_t>::max(); v = parent[v]) {
-				tempStack.push(v);
+template <typename IsTarget>
+bool Robot::createPathNearest(IsTarget&& isTarget, bool stopBeforeTarget) {
+	PathSearch& s = pathSearch;
+	const uint32_t search = s.begin(map.getSize());
+
+	s.queue.clear();
+	s.stamp[position_] = search;
+	s.parent[position_] = NO_TILE;
+	s.queue.push_back(static_cast<TileIndex>(position_));
+	for (size_t head = 0; head < s.queue.size();) {
+		const size_t current = s.queue[head++];
+		if (isTarget(current)) {
+			// Trasa od celu wstecz, dopisana za kolejką i odczytana od końca
+			const size_t first = s.queue.size();
+			for (size_t v = stopBeforeTarget ? s.parent[current] : current; v != position_ && v != NO_TILE; v = s.parent[v]) {
+				s.queue.push_back(static_cast<TileIndex>(v));
 			}
-			tempStack.pop();
-			while (tempStack.size() > 1) {
-				path.push(tempStack.top());
-				tempStack.pop();
+			for (size_t i = s.queue.size(); i > first; --i) {
+				path.push(s.queue[i - 1]);
 			}
 			return true;
 		}
 
-		std::vector<std::optional<size_t>> neighbours;
-		neighbours.push_back(map.getIndex(current, Direction::up));
-		neighbours.push_back(map.getIndex(current, Direction::down));
-		neighbours.push_back(map.getIndex(current, Direction::left));
-		neighbours.push_back(map.getIndex(current, Direction::right));
-
-		for (auto neighbour : neighbours) {
-			if (neighbour.has_value() && map.canMoveOn(*neighbour)) {
-				size_t idx = *neighbour;
-				if (!visited[idx]) {
-					visited[idx] = true;
-					parent[idx] = current;
-					q.push(idx);
-				}
+		map.forEachWalkableNeighbour(current, [&](size_t idx) {
+			if (s.stamp[idx] != search) {
+				s.stamp[idx] = search;
+				s.parent[idx] = static_cast<TileIndex>(current);
+				s.queue.push_back(static_cast<TileIndex>(idx));
 			}
-		}
+		});
 	}
 	return false;
 }
 
-bool Robot::createPathTrash() {
-	while (!path.empty()) {
-		path.pop();
+bool Robot::createPath(size_t targetId) {
+	path.reset(position_, map.getWidth(), map.getSize());
+	if (!canReach(targetId)) {
+		return false;
 	}
+	if (landmarks) {
+		return createPathLandmarks(targetId);
+	}
+	return createPathNearest([&](size_t tile) { return tile == targetId; }, false);
+}
 
-	std::vector<bool> visited(map.getSize(), false);
-	std::vector<size_t> parent(map.getSize(), std::numeric_limits<size_t>::max());
-	std::queue<size_t> q;
-
-	visited[position_] = true;
-	q.push(position_);
-	while (!q.empty()) {
-		size_t current = q.front();
-		Tile* tile = map.getTile(current);
-		q.pop();
-
-		auto floor = dynamic_cast<Floor*>(tile);
-		if (floor && floor->isDirty()) {
-			std::stack<size_t> tempStack;
-			for (size_t v = current; v != std::numeric_limits<size_t>::max(); v = parent[v]) {
-				tempStack.push(v);
+bool Robot::createPathLandmarks(size_t targetId) {
+	PathSearch& s = pathSearch;
+	const uint32_t search = s.begin(map.getSize());
+	// Priorytet: oszacowanie całej trasy, przy remisie dalej od startu
+	auto priority = [&](size_t tile, uint32_t cost) {
+		const uint64_t estimate = cost + landmarks->lowerBound(tile, targetId);
+		return (estimate << 32) | (UINT32_MAX - cost);
+	};
+	auto later = [](const std::pair<uint64_t, TileIndex>& a, const std::pair<uint64_t, TileIndex>& b) { return a.first > b.first; };
+
+	s.open.clear();
+	s.stamp[position_] = search;
+	s.cost[position_] = 0;
+	s.parent[position_] = NO_TILE;
+	s.open.emplace_back(priority(position_, 0), static_cast<TileIndex>(position_));
+	while (!s.open.empty()) {
+		std::pop_heap(s.open.begin(), s.open.end(), later);
+		const auto [key, current] = s.open.back();
+		s.open.pop_back();
+		const uint32_t cost = UINT32_MAX - static_cast<uint32_t>(key);
+		if (cost != s.cost[current]) {
+			continue;	// Stale entry, the tile was reached more cheaply
+		}
+		if (current == targetId) {
+			std::vector<size_t> reversed;
+			for (size_t v = targetId; v != position_; v = s.parent[v]) {
+				reversed.push_back(v);
 			}
-			tempStack.pop();
-			while (!tempStack.empty()) {
-				path.push(tempStack.top());
-				tempStack.pop();
+			for (auto it = reversed.rbegin(); it != reversed.rend(); ++it) {
+				path.push(*it);
 			}
 			return true;
 		}
 
-		std::vector<std::optional<size_t>> neighbours;
-		neighbours.push_back(map.getIndex(current, Direction::up));
-		neighbours.push_back(map.getIndex(current, Direction::down));
-		neighbours.push_back(map.getIndex(current, Direction::left));
-		neighbours.push_back(map.getIndex(current, Direction::right));
-
-		for (auto neighbour : neighbours) {
-			if (neighbour.has_value() && map.canMoveOn(*neighbour)) {
-				size_t idx = *neighbour;
-				if (!visited[idx]) {
-					visited[idx] = true;
-					parent[idx] = current;
-					q.push(idx);
-				}
+		map.forEachWalkableNeighbour(current, [&](size_t idx) {
+			if (s.stamp[idx] != search || cost + 1 < s.cost[idx]) {
+				s.stamp[idx] = search;
+				s.cost[idx] = cost + 1;
+				s.parent[idx] = current;
+				s.open.emplace_back(priority(idx, cost + 1), static_cast<TileIndex>(idx));
+				std::push_heap(s.open.begin(), s.open.end(), later);
 			}
-		}
+		});
 	}
 	return false;
 }
 
-bool Robot::createPathToVisit() {
-	while (!path.empty()) {
-		path.pop();
+bool Robot::setLandmarks(std::shared_ptr<const LandmarkTable> table) {
+	if (table && !table->fits(map)) {
+		landmarks.reset();
+		return false;
 	}
+	landmarks = std::move(table);
+	return true;
+}
 
-	std::vector<bool> visited(map.getSize(), false);
-	std::vector<size_t> parent(map.getSize(), std::numeric_limits<size_t>::max());
-	std::queue<size_t> q;
-
-	visited[position_] = true;
-	q.push(position_);
-	while (!q.empty()) {
-		size_t current = q.front();
-		q.pop();
+bool Robot::createPathUnvisited() {
+	path.reset(position_, map.getWidth(), map.getSize());
+	// Robot zatrzymuje się przed nieodwiedzonym kafelkiem, na który nie może jeszcze wjechać
+	return createPathNearest([&](size_t tile) { return getMemoryMap().getTile(tile)->getKind() == TileKind::unvisited; }, true);
+}
 
-		if (tilesToCheck[current]) {
-			std::stack<size_t> tempStack;
-			for (size_t v = current; v != std::numeric_limits<size_t>::max(); v = parent[v]) {
-				tempStack.push(v);
-			}
-			tempStack.pop();
-			while (!tempStack.empty()) {
-				path.push(tempStack.top());
-				tempStack.pop();
-			}
-			return true;
-		}
+bool Robot::createPathTrash() {
+	path.reset(position_, map.getWidth(), map.getSize());
+	return createPathNearest([&](size_t tile) {
+		const Floor* floor = getMemoryMap().getTile(tile)->asFloor();
+		return floor && floor->isDirty() && !isClaimed(tile);
+	}, false);
+}
 
-		std::vector<std::optional<size_t>> neighbours;
-		neighbours.push_back(map.getIndex(current, Direction::up));
-		neighbours.push_back(map.getIndex(current, Direction::down));
-		neighbours.push_back(map.getIndex(current, Direction::left));
-		neighbours.push_back(map.getIndex(current, Direction::right));
-
-		for (auto neighbour : neighbours) {
-			if (neighbour.has_value() && map.canMoveOn(*neighbour)) {
-				size_t idx = *neighbour;
-				if (!visited[idx]) {
-					visited[idx] = true;
-					parent[idx] = current;
-					q.push(idx);
-				}
-			}
-		}
+bool Robot::createPathToVisit() {
+	path.reset(position_, map.getWidth(), map.getSize());
+	// Kafelek pod robotem jest już sprawdzony; pusta trasa oznaczałaby postój w miejscu
+	tilesToCheck.reset(position_);
+	if (tilesToCheck.none()) {
+		return false;
 	}
-	return false;
+	return createPathNearest([&](size_t tile) { return tilesToCheck[tile]; }, false);
 }
 
-Robot::Robot(std::istream& in) {
+Robot::Robot(std::istream& in) : strategy(defaultStrategy()) {
     loadRobot(in);
 }
 
-Robot::Robot(size_t mapWidth, size_t mapHeight, size_t chargerId) {
+Robot::Robot(size_t mapWidth, size_t mapHeight, size_t chargerId) : strategy(defaultStrategy()) {
 	map = Map(mapWidth, mapHeight, chargerId);
-	tilesToCheck.assign(map.getSize(), false);
+	tilesToCheck.assign(map.getSize());
 	position_ = chargerId;
 	chargerId_ = chargerId;
 	currTask = RobotAction::explore;
@@ -272,7 +254,7 @@ bool Robot::isRobotValid() const {
     size_t chargerCount = 0;
     for (size_t i = 0; i < map.getSize(); ++i) {
         const Tile* tile = map.getTile(i);
-        if (dynamic_cast<const Charger*>(tile)) {
+        if (tile->getKind() == TileKind::charger) {
             chargerCount++;
         }
     }
@@ -304,7 +286,7 @@ bool Robot::isRobotStateValid() const {
 
     // Check if charger tile exists and is actually a charger
     const Tile* chargerTile = map.getTile(chargerId_);
-    if (!chargerTile || !dynamic_cast<const Charger*>(chargerTile)) {
+    if (!chargerTile || chargerTile->getKind() != TileKind::charger) {
         return false;
     }
 
@@ -319,10 +301,10 @@ bool Robot::isRobotStateValid() const {
     }
 
     // Validate path elements
-    std::queue<size_t> tempPath = path;
-    while (!tempPath.empty()) {
-        size_t pathElement = tempPath.front();
-        tempPath.pop();
+    if (!path.empty() && path.getStart() != position_) {
+        return false;
+    }
+    for (size_t pathElement : path) {
         if (pathElement >= map.getSize()) {
             return false;
         }
@@ -336,115 +318,128 @@ void Robot::setEfficiency(unsigned int efficiency) {
 	cleaningEfficiency = efficiency;
 }
 
-std::tuple<RobotAction, Direction> Robot::makeAction() {
-	// If in invalid place throw error
-	Tile* tile = map.getTile(position_);
-	if (position_ >= map.getSize() || !tile->isMoveValid()) {
+bool Robot::hasPath() {
+	return !path.empty();
+}
+
+bool Robot::createPathDirtyNeighbour() {
+	for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+		auto neighbour = map.getIndex(position_, dir);
+		if (!neighbour.has_value()) {
+			continue;
+		}
+		const Floor* floor = getMemoryMap().getTile(*neighbour)->asFloor();
+		if (floor && floor->isDirty() && !isClaimed(*neighbour)) {
+			// Neighbour is dirty, go there
+			createPath(*neighbour);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Robot::createPathToCharger() {
+	// Already in charger counts as failure, so the next rule looks for something to explore
+	return createPath(chargerId_) && position_ != chargerId_;
+}
+
+void Robot::setCleaningStrategy(std::shared_ptr<const CleaningStrategy> newStrategy) {
+	strategy = newStrategy ? std::move(newStrategy) : defaultStrategy();
+}
+
+RobotStep Robot::step() {
+	// If in invalid place report error
+	if (!map.canMoveOn(position_)) {
 		clearMoveTargets();
-		throw std::runtime_error("Robot is on invalid tile\n");
+		return { RobotAction::none, Direction::none, RobotError::invalidTile, position_ };
 	}
 
-	tilesToCheck[position_] = false;
+	tilesToCheck.reset(position_);
 
 	// Clean if trash
 	cleanTile();
 	if (cleaningEfficiency > 0) {
-		return std::make_tuple(RobotAction::clean, Direction::none);
+		return { RobotAction::clean, Direction::none };
 	}
 
-	if (currTask == RobotAction::explore) {		// Exploring mode
-		if (path.empty() && createPathUnvisited()) {
-			// Succesfully found new tile to explore
-			return std::make_tuple(RobotAction::move, move());
-		}
-		else if (path.empty()) {
+	// Each pass either returns an action or switches to another task
+	for (;;) {
+		switch (currTask) {
+		case RobotAction::explore:
+			if (!path.empty() || createPathUnvisited()) {
+				return move();
+			}
 			// All possible tiles explored
 			currTask = RobotAction::clean;
-			return makeAction();
-		}
-		else {
-			// Move towards current target
-			return std::make_tuple(RobotAction::move, move());
-		}
-	}
-	else if (currTask == RobotAction::move) {	// Moving mode
-		if (path.empty()) {
-			currTask = RobotAction::clean;
-			return makeAction();
-		}
-		else {
-			return std::make_tuple(RobotAction::move, move());
-		}
-	}
-	else if (currTask == RobotAction::clean) {	// Cleaning mode
-		// Check if neighbours need cleaning
-		std::vector<std::optional<size_t>> neighbours;
-		neighbours.push_back(map.getIndex(position_, Direction::up));
-		neighbours.push_back(map.getIndex(position_, Direction::down));
-		neighbours.push_back(map.getIndex(position_, Direction::left));
-		neighbours.push_back(map.getIndex(position_, Direction::right));
-
-		for (auto neighbour : neighbours) {
-			if (neighbour.has_value() && map.getTile(*neighbour)) {
-				if (auto floor = dynamic_cast<Floor*>(map.getTile(*neighbour))) {
-					if (floor->isDirty()) {
-						// Neighbour is dirty, go there
-						createPath(*neighbour);
-						return std::make_tuple(RobotAction::move, move());
-					}
-				}
+			break;
+
+		case RobotAction::move:
+			if (!path.empty()) {
+				return move();
 			}
-		}
+			currTask = RobotAction::clean;
+			break;
 
-		// Neighbours are clean
-		if (!path.empty()) {
-			// Go towards current target
-			return std::make_tuple(RobotAction::move, move());
-		}
-		else if (createPathTrash()) {
-			// Found trash in memory, go clean it
-			return std::make_tuple(RobotAction::move, move());
-		}
-		else if (createPathToVisit()) {
-			// Go to nearest tile to visit
-			return std::make_tuple(RobotAction::move, move());
-		}
-		else if (createPath(chargerId_)) {
-			// Return to charger
-			if (position_ == chargerId_) {
-				// Already in charger
-				if (createPathUnvisited()) {
-					// Explore
-					currTask = RobotAction::explore;
-					return std::make_tuple(RobotAction::move, move());
-				}
-				else {
-					// Nothing to do - all complete
-					currTask = RobotAction::none;
-					return makeAction();
-				}
+		case RobotAction::clean:
+			if (std::optional<RobotAction> nextTask = strategy->plan(*this)) {
+				currTask = *nextTask;
+				return move();
 			}
-			return std::make_tuple(RobotAction::move, move());
-		}
-		else if (createPathUnvisited()) {
-			// Can't reach charger, explore tiles
-			currTask = RobotAction::explore;
-			return std::make_tuple(RobotAction::move, move());
-		}
-		else {
-			// Can't reach charger and nothing to explore, error
-			throw std::runtime_error("Robot can't reach charger\n");
+			if (position_ != chargerId_) {
+				// Can't reach charger and nothing to explore
+				return { RobotAction::none, Direction::none, RobotError::chargerUnreachable, chargerId_ };
+			}
+			// Nothing to do - all complete
+			currTask = RobotAction::none;
+			break;
+
+		case RobotAction::none:
+			return { RobotAction::none, Direction::none };
+
+		default:
+			return { RobotAction::none, Direction::none, RobotError::unknownMode, position_ };
 		}
 	}
-	else if (currTask == RobotAction::none) {
-		return std::make_tuple(RobotAction::none, Direction::none);
+}
+
+std::string Robot::errorMessage(const RobotStep& step) {
+	switch (step.error) {
+	case RobotError::invalidTile:
+		return "Robot is on invalid tile\n";
+	case RobotError::unreachableTile:
+		return "Can't reach tile ID: " + std::to_string(step.errorTile) + "\n";
+	case RobotError::chargerUnreachable:
+		return "Robot can't reach charger\n";
+	case RobotError::unknownMode:
+		return "Unknown mode\n";
+	default:
+		return "";
 	}
+}
 
-	throw std::runtime_error("Unknown mode\n");
+std::tuple<RobotAction, Direction> Robot::makeAction() {
+	RobotStep result = step();
+	if (result.error != RobotError::none) {
+		throw std::runtime_error(errorMessage(result));
+	}
+	return std::make_tuple(result.action, result.direction);
 }
 
-void Robot::exploreTile(size_t tileId, const Tile* tileObj) {
-	map.updateTile(tileId, tileObj);
+std::vector<size_t> Robot::getTilesToCheckNear(size_t radius) const {
+	std::vector<size_t> result;
+	tilesToCheck.collectNear(position_, radius, map.getWidth(), result);
+	return result;
+}
+
+bool Robot::exploreTile(size_t tileId, const Tile* tileObj) {
+	if (!map.updateTile(tileId, tileObj)) {
+		return false;
+	}
+	// Nowe przejście, którego nie było przy liczeniu landmarków, mogłoby skrócić trasy poniżej ograniczeń
+	if (landmarks && map.canMoveOn(tileId) && !landmarks->wasWalkable(tileId)) {
+		landmarks.reset();
+	}
+	return true;
 }
 
 bool Robot::orderToGoHome() {
@@ -466,7 +461,18 @@ bool Robot::orderToMove(size_t id) {
 }
 
 void Robot::orderToCleanEfficiently() {
-	orderToClean(position_, -1);
+	clearMoveTargets();
+	currTask = RobotAction::move;
+
+	// One sweep over every reachable tile; tiles left out after a replan are visited later
+	CoveragePlanner planner(map);
+	tilesToCheck.set(position_);
+	bool continuous = true;
+	for (size_t tile : planner.plan(position_)) {
+		// Po przerwie w trasie pozostałe kafelki zostają tylko do sprawdzenia
+		continuous = continuous && path.push(tile);
+		tilesToCheck.set(tile);
+	}
 }
 
 bool Robot::orderToClean(size_t id, unsigned int radius) {
@@ -476,32 +482,32 @@ bool Robot::orderToClean(size_t id, unsigned int radius) {
 	}
 	currTask = RobotAction::move;
 
-	std::vector<bool> visited(tilesToCheck.size(), false);
+	std::vector<bool> visited(map.getSize(), false);
 	std::queue<std::pair<size_t, size_t>> q; // (index, distance)
-	std::vector<size_t> parent(map.getSize(), std::numeric_limits<size_t>::max());
+	std::vector<TileIndex> parent(map.getSize(), NO_TILE);
 
 	q.push({ id, 0 });
-	parent[id] = id;
+	parent[id] = static_cast<TileIndex>(id);
 	visited[id] = true;
-	tilesToCheck[id] = true;
+	tilesToCheck.set(id);
 
 	while (!q.empty()) {
 		auto [index, dist] = q.front();
 		q.pop();
 		if (dist > radius) continue;
 
-		const Tile* tile = map.getTile(index);
-		if (!tile || !tile->isMoveValid() || dynamic_cast<const UnVisited*>(tile)) continue;
+		const Tile* tile = getMemoryMap().getTile(index);
+		if (!tile || !tile->isWalkable()) continue;
 
 		if (!tilesToCheck[parent[index]]) {
-			tilesToCheck[index] = true;
+			tilesToCheck.set(index);
 		}
 
 		for (Direction dir : {Direction::up, Direction::down, Direction::left, Direction::right}) {
 			std::optional<size_t> nIndex = map.getIndex(index, dir);
 			if (nIndex && !visited[*nIndex]) {
 				visited[*nIndex] = true;
-				parent[*nIndex] = index;
+				parent[*nIndex] = static_cast<TileIndex>(index);
 				q.push({ *nIndex, dist + 1 });
 			}
 		}
@@ -509,25 +515,94 @@ bool Robot::orderToClean(size_t id, unsigned int radius) {
 	return true;
 }
 
+bool Robot::orderToCleanRegion(const Region& region) {
+	clearMoveTargets();
+
+	// Tylko wiersze i kolumny obszaru; kafelki z innej spójnej części mapy zostałyby na zawsze do sprawdzenia
+	const size_t width = map.getWidth();
+	region.forEachSpan(width, map.getHeight(), [&](size_t row, size_t first, size_t last) {
+		for (size_t id = row * width + first; id <= row * width + last; ++id) {
+			if (canReach(id) && map.canMoveOn(id)) {
+				tilesToCheck.set(id);
+			}
+		}
+	});
+	if (tilesToCheck.none()) {
+		return false;
+	}
+
+	createPathToVisit();
+	currTask = RobotAction::move;
+	return true;
+}
+
+void Robot::cancelMove(size_t previousPosition) {
+	if (previousPosition == position_) {
+		return;
+	}
+	// Zablokowany kafelek wraca na początek trasy
+	RobotPath rest = path;
+	path.reset(previousPosition, map.getWidth(), map.getSize());
+	path.push(position_);
+	for (size_t tile : rest) {
+		path.push(tile);
+	}
+	position_ = previousPosition;
+}
+
+bool Robot::sidestep(size_t tile) {
+	RobotPath rest = path;
+	path.reset(tile, map.getWidth(), map.getSize());
+	if (!map.canMoveOn(tile) || !path.push(position_)) {
+		path = rest;
+		return false;
+	}
+	for (size_t next : rest) {
+		path.push(next);
+	}
+	position_ = tile;
+	return true;
+}
+
+void Robot::dropPath() {
+	path.reset(position_, map.getWidth(), map.getSize());
+}
+
 void Robot::resetMemory() {
 	clearMoveTargets();
 	map = Map(map.getWidth(), map.getHeight(), map.getChargerId());
 	currTask = RobotAction::explore;
 }
 
-void Robot::loadRobot(std::istream& in) {
-    // Robot zawsze ładuje swoją mapę pamięci z UnVisited tiles
-    std::stringstream mapStream;
-    std::string line;
+RobotSnapshot Robot::snapshot() {
+	// Bufor trasy po długim planie bywa dużo większy od samej trasy - kopiowane są tylko kroki
+	RobotPath steps;
+	steps.reset(path.getStart(), map.getWidth(), map.getSize());
+	for (size_t tile : path) {
+		steps.push(tile);
+	}
+	return { position_, currTask, cleaningEfficiency, std::move(steps), landmarks, map.snapshot(), tilesToCheck.snapshot() };
+}
 
-    // Read map data first
-    while (std::getline(in, line)) {
-        if (line.empty()) break;
-        mapStream << line << "\n";
-    }
+void Robot::rollback(const RobotSnapshot& snapshot) {
+	map.rollback(snapshot.mapSnapshot);
+	tilesToCheck.rollback(snapshot.tilesToCheckSnapshot);
+	position_ = snapshot.position;
+	currTask = snapshot.task;
+	cleaningEfficiency = snapshot.cleaningEfficiency;
+	path = snapshot.path;
+	landmarks = snapshot.landmarks;
+}
+
+void Robot::commit() noexcept {
+	map.commit();
+	tilesToCheck.commit();
+}
 
-    // Load map with UnVisited tiles allowed (robot's memory)
-    map.loadMap(mapStream, true);
+void Robot::loadRobot(std::istream& in) {
+    // Robot zawsze ładuje swoją mapę pamięci z UnVisited tiles
+    // Map data ends at the first empty line, robot state follows in the same stream
+    map.loadMapSection(in, true);
 
     // Read robot state data
     int currTaskInt;
@@ -541,26 +616,32 @@ void Robot::loadRobot(std::istream& in) {
 
     // Read tilesToCheck
     in >> tilesSize;
-    tilesToCheck.resize(tilesSize);
+    tilesToCheck.commit();
+    tilesToCheck.assign(tilesSize);
     for (size_t i = 0; i < tilesSize; ++i) {
         bool val;
         in >> val;
-        tilesToCheck[i] = val;
+        tilesToCheck.set(i, val);
     }
 
     // Read path
+    // Each path element must be a neighbour of the previous one, starting from the robot
     in >> pathSize;
-    std::queue<size_t> tempQueue;
+    path.reset(position_, map.getWidth(), map.getSize());
     for (size_t i = 0; i < pathSize; ++i) {
         size_t elem;
         in >> elem;
-        tempQueue.push(elem);
+        if (!path.push(elem)) {
+            throw std::runtime_error("Invalid robot path at tile ID: " + std::to_string(elem) + "\n");
+        }
+    }
+    if (landmarks && !landmarks->fits(map)) {
+        landmarks.reset();
     }
-    path = std::move(tempQueue);
 }
 
-void Robot::saveRobot(std::ostream& out) const {
-	map.saveMap(out);
+void Robot::saveRobot(std::ostream& out, MapFormat format) const {
+	map.saveMap(out, format);
 	out << "\n";
 
 	out << position_ << ' ' << chargerId_ << ' ';
@@ -568,15 +649,13 @@ void Robot::saveRobot(std::ostream& out) const {
 	out << cleaningEfficiency << ' ';
 
 	out << tilesToCheck.size() << ' ';
-	for (bool b : tilesToCheck) {
-		out << b << ' ';
+	for (size_t i = 0; i < tilesToCheck.size(); ++i) {
+		out << tilesToCheck[i] << ' ';
 	}
 
 	out << path.size() << ' ';
-	std::queue<size_t> tempQueue = path;
-	while (!tempQueue.empty()) {
-		out << tempQueue.front() << ' ';
-		tempQueue.pop();
+	for (size_t tile : path) {
+		out << tile << ' ';
 	}
 
 	out << "\n";
@@ -7,7 +7,12 @@
 #include <string>
 #include <sstream>
 #include <limits>
+#include <memory>
 #include "Map.h"
+#include "TileBitset.h"
+#include "RobotPath.h"
+#include "Region.h"
+#include "LandmarkTable.h"
 
 enum class RobotAction {
 	move,
@@ -16,22 +21,66 @@ enum class RobotAction {
 	none
 };
 
+// Błędy kroku robota zwracane zamiast wyjątków
+enum class RobotError {
+	none,
+	invalidTile,		// Robot stands on a tile it can't be on
+	unreachableTile,	// Next tile of the path is blocked and there is no other route
+	chargerUnreachable,
+	unknownMode
+};
+
+struct RobotStep {
+	RobotAction action = RobotAction::none;
+	Direction direction = Direction::none;
+	RobotError error = RobotError::none;
+	size_t errorTile = 0;
+};
+
+// Stan robota zapamiętany przez Robot::snapshot. Pamięć mapy i kafelki do sprawdzenia
+// są cofane z dzienników zmian, tutaj są tylko znaczniki tych dzienników.
+struct RobotSnapshot {
+	size_t position = 0;
+	RobotAction task = RobotAction::none;
+	unsigned int cleaningEfficiency = 0;
+	RobotPath path;
+	std::shared_ptr<const LandmarkTable> landmarks;
+	size_t mapSnapshot = 0;
+	size_t tilesToCheckSnapshot = 0;
+};
+
+class CleaningStrategy;
+
 class Robot {
 private:
+	friend class CleaningStrategy;
+
 	size_t position_;
 	size_t chargerId_;
-	std::queue<size_t> path;
+	RobotPath path;
 	Map map;
 	RobotAction currTask;
 	unsigned int cleaningEfficiency = 0;
-	std::vector<bool> tilesToCheck;
+	TileBitset tilesToCheck;
+	std::shared_ptr<const CleaningStrategy> strategy;
+	const TileBitset* claimedTiles = nullptr;
+	std::shared_ptr<const LandmarkTable> landmarks;
 
-	Direction move();
+	RobotStep move();
 	void cleanTile();
+	bool canReach(size_t targetId) const;
+	// Breadth-first route to the nearest tile accepted by isTarget, ending next to it when stopBeforeTarget
+	template <typename IsTarget>
+	bool createPathNearest(IsTarget&& isTarget, bool stopBeforeTarget);
 	bool createPath(size_t targetId);
+	bool createPathLandmarks(size_t targetId);
 	bool createPathUnvisited();
 	bool createPathTrash();
 	bool createPathToVisit();
+	bool createPathDirtyNeighbour();
+	bool createPathToCharger();
+	bool hasPath();
+	bool isClaimed(size_t tile) const noexcept { return claimedTiles && claimedTiles->test(tile); }
 	void clearMoveTargets();
 public:
 	Robot() = delete;
@@ -46,18 +95,50 @@ public:
 	unsigned int getCleaningEfficiency() const noexcept { return cleaningEfficiency; }
 	const Map& getMemoryMap() const noexcept { return map; }
 	RobotAction getCurrTask() const noexcept { return currTask; }
+	const RobotPath& getPath() const noexcept { return path; }
+	const CleaningStrategy& getCleaningStrategy() const noexcept { return *strategy; }
+	// nullptr restores the default greedy strategy
+	void setCleaningStrategy(std::shared_ptr<const CleaningStrategy> newStrategy);
+	// Dirty tiles other robots already went for; trash planners skip them. nullptr turns it off
+	void setClaimedTiles(const TileBitset* claimed) noexcept { claimedTiles = claimed; }
+	// Single-target routes use A* with lower bounds from the table; false (and off) if the table
+	// doesn't fit the memory map. nullptr turns it off
+	bool setLandmarks(std::shared_ptr<const LandmarkTable> table);
+	const LandmarkTable* getLandmarks() const noexcept { return landmarks.get(); }
+	size_t getTilesToCheckCount() const noexcept { return tilesToCheck.count(); }
+	// Tiles still to visit within the given square radius of the robot
+	std::vector<size_t> getTilesToCheckNear(size_t radius) const;
 
+	// Same as makeAction, but reports errors in the result instead of throwing
+	RobotStep step();
 	std::tuple<RobotAction, Direction> makeAction();
-	void exploreTile(size_t tileId, const Tile* tileObj);
+	static std::string errorMessage(const RobotStep& step);
+	bool exploreTile(size_t tileId, const Tile* tileObj);
 
 	void orderToCleanEfficiently();
 	bool orderToGoHome();
 	bool orderToMove(size_t id);
 	bool orderToClean(size_t id, unsigned int radius);
+	// Marks the walkable tiles of the region reachable from the robot; false if there are none
+	bool orderToCleanRegion(const Region& region);
 	void resetMemory();
 
+	// Undoes the last move step when another robot holds the tile; the route is kept
+	void cancelMove(size_t previousPosition);
+	// Moves to an adjacent tile to make way and returns to the route from there
+	bool sidestep(size_t tile);
+	// Forgets the route but keeps the task and tiles to check; the next step plans again
+	void dropPath();
+
+	// Lookahead: state changes after snapshot are undone by rollback in time proportional to them.
+	// Strategy, claimed tiles and charger are not part of the snapshot
+	RobotSnapshot snapshot();
+	void rollback(const RobotSnapshot& snapshot);
+	// Keeps the current state and stops logging changes
+	void commit() noexcept;
+
 	void loadRobot(std::istream& in);
-	void saveRobot(std::ostream& out) const;
+	void saveRobot(std::ostream& out, MapFormat format = MapFormat::text) const;
 
 	friend std::ostream& operator<<(std::ostream& os, const Robot& robot);
 };
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "RobotPath.h"
+
+RobotPath::const_iterator::const_iterator(const RobotPath* path, size_t step, size_t tile)
+    : path(path), step(step), tile(tile) {}
+
+RobotPath::const_iterator& RobotPath::const_iterator::operator++() {
+    step++;
+    if (step < path->count) {
+        tile = path->stepFrom(tile, path->codeAt(step));
+    }
+    return *this;
+}
+
+RobotPath::const_iterator RobotPath::const_iterator::operator++(int) {
+    const_iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+Direction RobotPath::codeAt(size_t step) const noexcept {
+    const size_t index = (head + step) & (capacity() - 1);
+    const uint64_t code = (codes[index / CODES_PER_WORD] >> (2 * (index % CODES_PER_WORD))) & 3u;
+    return static_cast<Direction>(code);
+}
+
+void RobotPath::grow() {
+    std::vector<uint64_t> grown(codes.empty() ? 1 : codes.size() * 2, 0);
+    // Przepisuje kroki od początku nowego bufora
+    for (size_t step = 0; step < count; ++step) {
+        const uint64_t code = static_cast<uint64_t>(codeAt(step));
+        grown[step / CODES_PER_WORD] |= code << (2 * (step % CODES_PER_WORD));
+    }
+    codes = std::move(grown);
+    head = 0;
+}
+
+void RobotPath::reset(size_t startTile, size_t mapWidth, size_t mapTiles) {
+    start = startTile;
+    last = startTile;
+    width = mapWidth;
+    mapSize = mapTiles;
+    head = 0;
+    count = 0;
+}
+
+void RobotPath::clear() noexcept {
+    last = start;
+    head = 0;
+    count = 0;
+}
+
+size_t RobotPath::stepFrom(size_t tile, Direction dir) const noexcept {
+    switch (dir) {
+    case Direction::up:
+        return tile - width;
+    case Direction::down:
+        return tile + width;
+    case Direction::left:
+        return tile - 1;
+    case Direction::right:
+        return tile + 1;
+    default:
+        return tile;
+    }
+}
+
+bool RobotPath::push(size_t tile) {
+    if (width == 0 || tile >= mapSize) {
+        return false;
+    }
+
+    Direction dir;
+    if (tile + width == last) {
+        dir = Direction::up;
+    }
+    else if (last + width == tile) {
+        dir = Direction::down;
+    }
+    else if (tile + 1 == last && last % width != 0) {
+        dir = Direction::left;
+    }
+    else if (last + 1 == tile && tile % width != 0) {
+        dir = Direction::right;
+    }
+    else {
+        return false;
+    }
+
+    if (count == capacity()) {
+        grow();
+    }
+    const size_t index = (head + count) & (capacity() - 1);
+    uint64_t& word = codes[index / CODES_PER_WORD];
+    const size_t shift = 2 * (index % CODES_PER_WORD);
+    word = (word & ~(uint64_t(3) << shift)) | (static_cast<uint64_t>(dir) << shift);
+    count++;
+    last = tile;
+    return true;
+}
+
+void RobotPath::pop() {
+    if (count == 0) {
+        return;
+    }
+    start = stepFrom(start, codeAt(0));
+    head = (head + 1) & (capacity() - 1);
+    count--;
+}
+
+size_t RobotPath::front() const noexcept {
+    return count == 0 ? start : stepFrom(start, codeAt(0));
+}
+
+Direction RobotPath::frontDirection() const noexcept {
+    return count == 0 ? Direction::none : codeAt(0);
+}
+
+RobotPath::const_iterator RobotPath::begin() const {
+    return count == 0 ? end() : const_iterator(this, 0, front());
+}
+
+RobotPath::const_iterator RobotPath::end() const {
+    return const_iterator(this, count, last);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "Map.h"
+
+// Ścieżka robota: kafelek startowy i kolejne kroki zapisane jako 2-bitowe kierunki
+// w buforze cyklicznym. Elementami ścieżki są kafelki po każdym kroku (bez startu).
+class RobotPath {
+private:
+    static constexpr size_t CODES_PER_WORD = 32;
+
+    std::vector<uint64_t> codes; // Bufor cykliczny, pojemność jest potęgą dwójki
+    size_t head = 0;             // Indeks pierwszego kroku w buforze
+    size_t count = 0;
+    size_t start = 0;            // Kafelek przed pierwszym krokiem
+    size_t last = 0;             // Kafelek po ostatnim kroku
+    size_t width = 0;
+    size_t mapSize = 0;
+
+    size_t capacity() const noexcept { return codes.size() * CODES_PER_WORD; }
+    Direction codeAt(size_t step) const noexcept;
+    void grow();
+
+public:
+    class const_iterator {
+    private:
+        const RobotPath* path = nullptr;
+        size_t step = 0;
+        size_t tile = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = size_t;
+
+        const_iterator() = default;
+        const_iterator(const RobotPath* path, size_t step, size_t tile);
+
+        size_t operator*() const noexcept { return tile; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator& other) const noexcept { return step == other.step; }
+        bool operator!=(const const_iterator& other) const noexcept { return step != other.step; }
+    };
+
+    RobotPath() = default;
+
+    // Clears the path and starts it at the given tile of a map with the given dimensions
+    void reset(size_t startTile, size_t mapWidth, size_t mapTiles);
+    // Clears the path keeping the current start and map dimensions
+    void clear() noexcept;
+
+    // Appends a step to a neighbour of back(); returns false if tile is not a neighbour
+    bool push(size_t tile);
+    // Removes the first step; its tile becomes the new start
+    void pop();
+
+    bool empty() const noexcept { return count == 0; }
+    size_t size() const noexcept { return count; }
+    size_t getStart() const noexcept { return start; }
+    size_t front() const noexcept;
+    Direction frontDirection() const noexcept;
+    size_t back() const noexcept { return last; }
+    size_t memoryBytes() const noexcept { return codes.capacity() * sizeof(uint64_t); }
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    // Tile reached from tile by one step in dir; tile itself for Direction::none
+    size_t stepFrom(size_t tile, Direction dir) const noexcept;
+};
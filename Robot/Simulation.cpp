@@ -9,10 +9,13 @@
 #include <chrono>
 #include <optional>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include <algorithm>
+#include <iomanip>
 
 #include "Messages.h"
+#include "Fleet.h"
 
 static std::mt19937 gen(std::chrono::system_clock::now().time_since_epoch().count());
 
@@ -142,8 +145,7 @@ bool Simulation::isSimulationValid() const {
     }
 
     // Check if the tile at charger ID is actually a charger
-    const Charger* charger = dynamic_cast<const Charger*>(chargerTile);
-    if (!charger) {
+    if (chargerTile->getKind() != TileKind::charger) {
         std::cerr << "Validation Error: Tile at charger ID " << chargerId
             << " is not a charger tile.\n";
         return false;
@@ -161,10 +163,10 @@ bool Simulation::isSimulationValid() const {
 void Simulation::addRubbish(size_t tileId, unsigned int dirtiness) {
     std::cout << Messages::ADD_RUBBISH_ACTION << dirtiness << " rubbish to Tile ID: " << tileId << ".\n";
 
-    Tile* targetTile = map.getTile(tileId);
+    const Tile* targetTile = map.getTile(tileId);
 
     if (targetTile) {
-        Floor* floorTile = dynamic_cast<Floor*>(targetTile);
+        Floor* floorTile = map.editFloor(tileId);
         if (floorTile) {
             floorTile->getDirty(dirtiness);
             std::cout << Messages::RUBBISH_ADDED_SUCCESS_PART1 << tileId << Messages::RUBBISH_ADDED_SUCCESS_PART2 << floorTile->getCleanliness() << Messages::RUBBISH_ADDED_SUCCESS_PART3;
@@ -191,8 +193,8 @@ void Simulation::addSerialRubbish(unsigned int totalRubbishAmount) {
 
     std::vector<size_t> floorTileIds;
     for (size_t i = 0; i < map.getSize(); ++i) {
-        Tile* currentTile = map.getTile(i);
-        if (currentTile && dynamic_cast<Floor*>(currentTile)) {
+        const Tile* currentTile = map.getTile(i);
+        if (currentTile && currentTile->isFloor()) {
             floorTileIds.push_back(i);
         }
     }
@@ -215,7 +217,7 @@ void Simulation::addSerialRubbish(unsigned int totalRubbishAmount) {
 
         while (attempts < maxAttemptsToFindTile && !tileDirtiedInThisIteration) {
             size_t tileId = floorTileIds[tileIndexDistrib(gen)];
-            Floor* floorTile = dynamic_cast<Floor*>(map.getTile(tileId));
+            Floor* floorTile = map.editFloor(tileId);
 
             if (floorTile) {
                 unsigned int currentCleanliness = floorTile->getCleanliness();
@@ -314,6 +316,70 @@ void Simulation::orderRobotToCleanEfficiently() {
     std::cout << Messages::ROBOT_ORDER_CLEAN_EFFICIENTLY_SUCCESS;
 }
 
+// Orders the robot to clean every known floor tile inside the region.
+void Simulation::orderRobotToCleanRegion(const Region& region) {
+    if (robot.orderToCleanRegion(region)) {
+        std::cout << Messages::ROBOT_ORDER_CLEAN_AREA_SUCCESS << robot.getTilesToCheckCount()
+            << Messages::ROBOT_ORDER_CLEAN_AREA_SUCCESS_CONT;
+    }
+    else {
+        std::cout << Messages::ROBOT_ORDER_CLEAN_AREA_FAIL;
+    }
+}
+
+// Orders the robot to clean a named zone loaded with the simulation.
+void Simulation::orderRobotToCleanZone(const std::string& name) {
+    const Region* region = zones.find(name);
+    if (!region) {
+        std::cout << Messages::UNKNOWN_ZONE_ERROR << name << ".\n";
+        return;
+    }
+    orderRobotToCleanRegion(*region);
+}
+
+// Computes a landmark table on the simulation map and gives it to the robot.
+void Simulation::buildLandmarks(size_t count) {
+    landmarks = std::make_shared<const LandmarkTable>(LandmarkTable::build(map, count));
+    robot.setLandmarks(landmarks);
+    std::cout << Messages::LANDMARKS_BUILT << landmarks->getLandmarks().size() << Messages::LANDMARKS_BUILT_CONT;
+}
+
+// Runs copies of the current robot on the simulation map and prints per-robot metrics.
+void Simulation::runFleet(size_t robotCount, unsigned int steps) {
+    if (robotCount == 0) {
+        std::cout << Messages::FLEET_SIZE_ERROR;
+        return;
+    }
+
+    Fleet fleet(map);
+    try {
+        fleet.addRobot(robot);
+        for (size_t i = 1; i < robotCount; ++i) {
+            Robot copy = robot;
+            copy.setPosition(map.getChargerId());
+            fleet.addRobot(std::move(copy));
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << Messages::ROBOT_ERROR_MESSAGE << e.what() << std::endl;
+        return;
+    }
+
+    size_t ticks = fleet.run(steps);
+    std::cout << Messages::FLEET_FINISHED << ticks << Messages::FLEET_FINISHED_CONT << fleet.getActiveCount() << ".\n";
+    std::cout << Messages::FLEET_METRICS_HEADER;
+    const FleetMetrics& metrics = fleet.getMetrics();
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        std::cout << std::setw(5) << i << std::setw(10) << fleet.getPosition(i) << std::setw(7) << metrics.moves[i]
+            << std::setw(8) << metrics.cleans[i] << std::setw(7) << metrics.waits[i] << std::setw(11) << metrics.sidesteps[i]
+            << std::setw(14) << metrics.dirtCleaned[i] << "  "
+            << (fleet.getError(i) == RobotError::none ? "-" : Robot::errorMessage({ RobotAction::none, Direction::none, fleet.getError(i), fleet.getErrorTile(i) }));
+        if (fleet.getError(i) == RobotError::none) {
+            std::cout << "\n";
+        }
+    }
+}
+
 // Resets the robot's memory of the map.
 void Simulation::resetRobotMemory() {
     robot.resetMemory();
@@ -328,10 +394,29 @@ void Simulation::saveSimulation(fs::path filePath) {
         return;
     }
 
+    // Pliki .rle są zapisywane w formacie run-length
+    MapFormat format = filePath.extension() == ".rle" ? MapFormat::rle : MapFormat::text;
+
     try {
-        map.saveMap(outFile);
+        map.saveMap(outFile, format);
         outFile << "\n";
-        robot.saveRobot(outFile);
+        robot.saveRobot(outFile, format);
+        // Plik obok bez stref lub landmarków zostałby wczytany razem z nowym zapisem
+        std::error_code ec;
+        if (!zones.empty()) {
+            std::ofstream zonesFile(ZoneSet::sidecarPath(filePath));
+            zones.save(zonesFile);
+        }
+        else {
+            fs::remove(ZoneSet::sidecarPath(filePath), ec);
+        }
+        if (landmarks) {
+            std::ofstream landmarksFile(LandmarkTable::sidecarPath(filePath), std::ios::binary);
+            landmarks->save(landmarksFile);
+        }
+        else {
+            fs::remove(LandmarkTable::sidecarPath(filePath), ec);
+        }
         std::cout << Messages::SIMULATION_SAVE_SUCCESS << filePath << std::endl;
     }
     catch (const std::exception& e) {
@@ -504,10 +589,10 @@ void Simulation::updateRobotMemory(size_t tileId, const Tile* tileObj) {
 // Cleans a specific tile on the map.
 void Simulation::cleanTile(size_t tileId, unsigned int efficiency) {
     std::cout << Messages::INTERNAL_CLEANING_ATTEMPT << tileId << Messages::INTERNAL_CLEANING_ATTEMPT_CONT << efficiency << Messages::INTERNAL_CLEANING_ATTEMPT_CONT2;
-    Tile* targetTile = map.getTile(tileId);
+    const Tile* targetTile = map.getTile(tileId);
 
     if (targetTile) {
-        Floor* floorTile = dynamic_cast<Floor*>(targetTile);
+        Floor* floorTile = map.editFloor(tileId);
         if (floorTile) {
             floorTile->getCleaned(efficiency);
             std::cout << Messages::INTERNAL_TILE_CLEANED << tileId << Messages::INTERNAL_TILE_CLEANED_CONT << floorTile->getCleanliness() << Messages::INTERNAL_TILE_CLEANED_CONT2;
@@ -631,6 +716,10 @@ void Simulation::start(fs::path filePath) {
         std::cout << Messages::MAIN_MENU_OPTION_9;
         std::cout << Messages::MAIN_MENU_OPTION_10;
         std::cout << Messages::MAIN_MENU_OPTION_11;
+        std::cout << Messages::MAIN_MENU_OPTION_12;
+        std::cout << Messages::MAIN_MENU_OPTION_13;
+        std::cout << Messages::MAIN_MENU_OPTION_14;
+        std::cout << Messages::MAIN_MENU_OPTION_15;
         std::cout << Messages::MAIN_MENU_OPTION_0;
         std::cout << Messages::ENTER_CHOICE_PROMPT;
 
@@ -674,7 +763,7 @@ void Simulation::start(fs::path filePath) {
 
                 std::vector<size_t> floorTileIds;
                 for (size_t i = 0; i < map.getSize(); ++i) {
-                    if (dynamic_cast<Floor*>(map.getTile(i))) {
+                    if (map.getTile(i)->isFloor()) {
                         floorTileIds.push_back(i);
                     }
                 }
@@ -691,7 +780,7 @@ void Simulation::start(fs::path filePath) {
                 while (!foundValidTile && attempts < maxAttempts) {
                     size_t randomIndex = distrib(gen);
                     tileId = floorTileIds[randomIndex];
-                    Floor* floorTile = dynamic_cast<Floor*>(map.getTile(tileId));
+                    const Floor* floorTile = map.getTile(tileId)->asFloor();
 
                     if (floorTile && floorTile->getCleanliness() < 9) {
                         foundValidTile = true;
@@ -713,13 +802,13 @@ void Simulation::start(fs::path filePath) {
             else {
                 try {
                     tileId = std::stoul(input);
-                    Tile* targetTile = map.getTile(tileId);
-                    if (!targetTile || !dynamic_cast<Floor*>(targetTile)) {
+                    const Tile* targetTile = map.getTile(tileId);
+                    if (!targetTile || !targetTile->isFloor()) {
                         std::cerr << Messages::INVALID_TILE_ID_NOT_FLOOR << tileId << Messages::INVALID_TILE_ID_NOT_FLOOR_CONT;
                         addLog("Invalid tile ID for rubbish addition: " + std::to_string(tileId));
                         break;
                     }
-                    if (dynamic_cast<Floor*>(targetTile)->getCleanliness() == 9) {
+                    if (targetTile->asFloor()->getCleanliness() == 9) {
                         std::cerr << Messages::TILE_ID_ALREADY_MAX_DIRTY << tileId << Messages::TILE_ID_ALREADY_MAX_DIRTY_CONT;
                         addLog("Attempted to add rubbish to already max dirty tile: " + std::to_string(tileId));
                         break;
@@ -735,7 +824,7 @@ void Simulation::start(fs::path filePath) {
 
             if (foundValidTile) {
                 unsigned int dirtiness = getValidatedUnsignedIntInput(Messages::ENTER_DIRTINESS_LEVEL_PROMPT);
-                Floor* floorTile = dynamic_cast<Floor*>(map.getTile(tileId));
+                const Floor* floorTile = map.getTile(tileId)->asFloor();
                 unsigned int maxAddable = 9 - floorTile->getCleanliness();
                 if (dirtiness > maxAddable) {
                     std::cout << Messages::WARNING_DIRTINESS_CAP << dirtiness << Messages::WARNING_DIRTINESS_CAP_CONT << maxAddable << Messages::WARNING_DIRTINESS_CAP_CONT2;
@@ -820,6 +909,46 @@ void Simulation::start(fs::path filePath) {
             orderRobotToCleanEfficiently();
             break;
         }
+        case 12: {
+            size_t left = getValidatedSizeTInput(Messages::ENTER_REGION_LEFT_PROMPT);
+            size_t top = getValidatedSizeTInput(Messages::ENTER_REGION_TOP_PROMPT);
+            size_t right = getValidatedSizeTInput(Messages::ENTER_REGION_RIGHT_PROMPT);
+            size_t bottom = getValidatedSizeTInput(Messages::ENTER_REGION_BOTTOM_PROMPT);
+            addLog("User ordered robot to clean area (" + std::to_string(left) + ", " + std::to_string(top) + ") - ("
+                + std::to_string(right) + ", " + std::to_string(bottom) + ")");
+            orderRobotToCleanRegion(Region::rect(static_cast<int64_t>(left), static_cast<int64_t>(top),
+                static_cast<int64_t>(right), static_cast<int64_t>(bottom)));
+            break;
+        }
+        case 13: {
+            if (zones.empty()) {
+                std::cout << Messages::NO_ZONES_DEFINED;
+                break;
+            }
+            std::cout << Messages::AVAILABLE_ZONES;
+            for (const ZoneSet::Zone& zone : zones.getZones()) {
+                std::cout << " " << zone.name;
+            }
+            std::cout << "\n" << Messages::ENTER_ZONE_NAME_PROMPT;
+            std::string name;
+            std::getline(std::cin, name);
+            addLog("User ordered robot to clean zone: " + name);
+            orderRobotToCleanZone(name);
+            break;
+        }
+        case 14: {
+            size_t robotCount = getValidatedSizeTInput(Messages::ENTER_FLEET_SIZE_PROMPT);
+            unsigned int steps = getValidatedUnsignedIntInput(Messages::ENTER_SIM_STEPS_PROMPT);
+            addLog("User chose to run a fleet of " + std::to_string(robotCount) + " robots for " + std::to_string(steps) + " steps.");
+            runFleet(robotCount, steps);
+            break;
+        }
+        case 15: {
+            size_t count = getValidatedSizeTInput(Messages::ENTER_LANDMARK_COUNT_PROMPT);
+            addLog("User chose to precompute " + std::to_string(count) + " landmarks.");
+            buildLandmarks(count);
+            break;
+        }
         case 0: {
             addLog("User chose to exit simulation.");
             exitSimulation();
@@ -879,29 +1008,50 @@ void Simulation::loadFromFile(fs::path filePath) {
         std::cerr << Messages::ERROR_COULD_NOT_OPEN_FILE << filePath << std::endl;
         return;
     }
+    loadFromStream(inputFile);
 
-    std::stringstream mapDataStream;
-    std::stringstream robotDataStream;
-    std::string line;
-    bool readingMap = true;
-    while (std::getline(inputFile, line)) {
-        if (readingMap) {
-            if (line.empty()) {
-                readingMap = false;
+    // Strefy z pliku obok symulacji, jeśli istnieje
+    zones.clear();
+    std::ifstream zonesFile(ZoneSet::sidecarPath(filePath));
+    if (zonesFile.is_open()) {
+        try {
+            zones.load(zonesFile);
+            std::cout << Messages::ZONES_LOADED << zones.size() << "\n";
+        }
+        catch (const std::exception& e) {
+            std::cerr << Messages::ERROR_LOADING_ZONES << e.what() << std::endl;
+            zones.clear();
+        }
+    }
+
+    // Landmarki policzone wcześniej dla tej mapy
+    std::ifstream landmarksFile(LandmarkTable::sidecarPath(filePath), std::ios::binary);
+    if (landmarksFile.is_open()) {
+        try {
+            auto table = std::make_shared<LandmarkTable>();
+            table->load(landmarksFile);
+            if (table->fits(map) && robot.setLandmarks(table)) {
+                landmarks = std::move(table);
+                std::cout << Messages::LANDMARKS_LOADED << landmarks->getLandmarks().size() << "\n";
             }
             else {
-                mapDataStream << line << "\n";
+                std::cout << Messages::LANDMARKS_STALE;
             }
         }
-        else {
-            robotDataStream << line << "\n";
+        catch (const std::exception& e) {
+            std::cerr << Messages::ERROR_LOADING_LANDMARKS << e.what() << std::endl;
         }
     }
-    inputFile.close();
+}
 
+// Loads simulation data (map and robot) from any input stream, e.g. a pipe or std::cin.
+void Simulation::loadFromStream(std::istream& in) {
+    // Landmarki należą do poprzedniej mapy
+    landmarks.reset();
+    robot.setLandmarks(nullptr);
     try {
         // Load simulation map without UnVisited tiles (real world)
-        map.loadMap(mapDataStream, false);
+        map.loadMapSection(in, false);
         std::cout << Messages::MAP_DATA_LOADED_SUCCESSFULLY;
     }
     catch (const std::exception& e) {
@@ -910,7 +1060,8 @@ void Simulation::loadFromFile(fs::path filePath) {
         return;
     }
 
-    if (robotDataStream.str().empty()) {
+    in >> std::ws;
+    if (in.peek() == std::char_traits<char>::eof()) {
         std::cout << Messages::ROBOT_DATA_NOT_FOUND_INIT;
         // Create robot with UnVisited memory
         robot = Robot(map.getWidth(), map.getHeight(), map.getChargerId());
@@ -921,7 +1072,7 @@ void Simulation::loadFromFile(fs::path filePath) {
     else {
         try {
             // Robot loads with his memory map (can contain UnVisited)
-            robot.loadRobot(robotDataStream);
+            robot.loadRobot(in);
             std::cout << Messages::ROBOT_DATA_LOADED_SUCCESSFULLY;
         }
         catch (const std::exception& e) {
@@ -930,4 +1081,18 @@ void Simulation::loadFromFile(fs::path filePath) {
             robot = Robot(map.getWidth(), map.getHeight(), map.getChargerId());
         }
     }
-}
\ No newline at end of file
+}
+
+SimulationSnapshot Simulation::snapshot() {
+    return { map.snapshot(), robot.snapshot() };
+}
+
+void Simulation::rollback(const SimulationSnapshot& snapshot) {
+    map.rollback(snapshot.mapSnapshot);
+    robot.rollback(snapshot.robot);
+}
+
+void Simulation::commit() noexcept {
+    map.commit();
+    robot.commit();
+}
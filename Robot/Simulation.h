@@ -4,14 +4,22 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <memory>
 #include <sstream>
+#include <utility>
 #include <vector>
 #include "Robot.h"
 #include "Map.h"
+#include "Region.h"
 #include "FileManager.hpp"
 
 namespace fs = std::filesystem;
 
+struct SimulationSnapshot {
+    size_t mapSnapshot = 0;
+    RobotSnapshot robot;
+};
+
 class Simulation {
 private:
     // Logging members
@@ -21,6 +29,8 @@ private:
 
     Map map;
     Robot robot = Robot(0, 0, 0);
+    ZoneSet zones;
+    std::shared_ptr<const LandmarkTable> landmarks;
 
     std::vector<std::string> simulationLogs;
     void addLog(const std::string& message);
@@ -40,10 +50,13 @@ private:
     void orderRobotToMove(size_t targetTileId); // Robot moves to specific tile
     void orderRobotToClean(size_t tileId, unsigned int radius); // Robot cleans a specific tile with radius
     void orderRobotToCleanEfficiently(); // NEW: Declare this function here!
+    void orderRobotToCleanRegion(const Region& region);
+    void orderRobotToCleanZone(const std::string& name);
     void resetRobotMemory(); // No parameters needed
-    void saveSimulation(fs::path filePath); // Save to a specific file
     void loadSimulation(fs::path filePath); // Load from a specific file
     void runSimulation(unsigned int steps); // Run for N steps
+    void runFleet(size_t robotCount, unsigned int steps); // Run copies of the robot together on the map
+    void buildLandmarks(size_t count); // Precompute landmark distances for the robot's routes
     void exitSimulation(); // No parameters needed
 
     void printSimulation();
@@ -57,10 +70,24 @@ public:
     Simulation(size_t width = 0, size_t height = 0, size_t chargerId = 0)
         : map(width, height, chargerId), robot(width, height, chargerId) {
     }
+    // World map as a copy-on-write overlay of a map shared with other simulations
+    explicit Simulation(std::shared_ptr<const Map> baseMap)
+        : map(std::move(baseMap)), robot(map.getWidth(), map.getHeight(), map.getChargerId()) {
+    }
 
     // Main entry point
     void start(fs::path filePath = "");
     void loadFromFile(fs::path filePath);
+    void loadFromStream(std::istream& in);
+    // Zones and landmarks go to files next to filePath; a sidecar with nothing to save is removed
+    void saveSimulation(fs::path filePath);
+    const Map& getMap() const noexcept { return map; }
+    const Robot& getRobot() const noexcept { return robot; }
+
+    // Lookahead over the world map and the robot, see Map::snapshot; logs are not rolled back
+    SimulationSnapshot snapshot();
+    void rollback(const SimulationSnapshot& snapshot);
+    void commit() noexcept;
 };
 
 #endif // SIMULATION_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Map.h"
+#include "MapCodec.h"
+
+// Mapa o wymiarach znanych w czasie kompilacji, dla kilku stałych planów pięter.
+// Kafelki są kodami MapCodec w std::array z ramką jednej przeszkody dookoła (jak siatka przejezdności Map),
+// więc arytmetyka indeksów się zwija, a cały stan da się skopiować memcpy.
+// Zapytania mają te same nazwy i znaczenie co w Map, więc szablony wyszukiwań działają na obu.
+template <size_t W, size_t H>
+class StaticMap {
+    static_assert(W > 0 && H > 0, "StaticMap needs at least one tile");
+
+public:
+    static constexpr size_t WIDTH = W;
+    static constexpr size_t HEIGHT = H;
+
+private:
+    static constexpr size_t STRIDE = W + 2;
+
+    std::array<uint8_t, STRIDE * (H + 2)> cells;
+    size_t chargerId = Tile::INVALID_ID;
+
+    static constexpr size_t cellOf(size_t tileId) noexcept { return tileId + 2 * (tileId / W) + STRIDE + 1; }
+    static constexpr bool walkable(uint8_t code) noexcept { return code < MapCodec::OBSTACLE || code == MapCodec::CHARGER; }
+
+public:
+    // Same nieodwiedzone kafelki
+    StaticMap() noexcept {
+        cells.fill(MapCodec::OBSTACLE);
+        for (size_t tile = 0; tile < W * H; ++tile) {
+            cells[cellOf(tile)] = MapCodec::UNVISITED;
+        }
+    }
+
+    // Throws std::runtime_error when the dimensions differ
+    static StaticMap fromMap(const Map& map) {
+        if (map.getWidth() != W || map.getHeight() != H) {
+            throw std::runtime_error("Map is " + std::to_string(map.getWidth()) + "x" + std::to_string(map.getHeight())
+                + ", expected " + std::to_string(W) + "x" + std::to_string(H) + ".");
+        }
+        StaticMap result;
+        for (size_t tile = 0; tile < W * H; ++tile) {
+            result.updateTile(tile, map.getTile(tile));
+        }
+        return result;
+    }
+
+    Map toMap() const {
+        Map map(W, H, chargerId);
+        Obstacle obstacle;
+        Floor floor;
+        for (size_t tile = 0; tile < W * H; ++tile) {
+            const uint8_t code = cells[cellOf(tile)];
+            if (code == MapCodec::OBSTACLE) {
+                map.updateTile(tile, &obstacle);
+            }
+            else if (code < MapCodec::OBSTACLE) {
+                floor.setCleanliness(code);
+                map.updateTile(tile, &floor);
+            }
+        }
+        return map;
+    }
+
+    static constexpr size_t getWidth() noexcept { return W; }
+    static constexpr size_t getHeight() noexcept { return H; }
+    static constexpr size_t getSize() noexcept { return W * H; }
+    size_t getChargerId() const noexcept { return chargerId; }
+
+    std::optional<size_t> getIndex(size_t position, Direction direction) const noexcept {
+        if (position >= W * H) {
+            return std::nullopt;
+        }
+        const size_t row = position / W;
+        const size_t col = position % W;
+        switch (direction) {
+        case Direction::up:
+            return row == 0 ? std::nullopt : std::optional<size_t>(position - W);
+        case Direction::down:
+            return row + 1 == H ? std::nullopt : std::optional<size_t>(position + W);
+        case Direction::left:
+            return col == 0 ? std::nullopt : std::optional<size_t>(position - 1);
+        case Direction::right:
+            return col + 1 == W ? std::nullopt : std::optional<size_t>(position + 1);
+        default:
+            return position;
+        }
+    }
+
+    bool canMoveOn(size_t tileId) const noexcept { return tileId < W * H && walkable(cells[cellOf(tileId)]); }
+
+    template <typename Fn>
+    void forEachWalkableNeighbour(size_t tileId, Fn&& fn) const {
+        const uint8_t* cell = cells.data() + cellOf(tileId);
+        if (walkable(*(cell - STRIDE))) {
+            fn(tileId - W);
+        }
+        if (walkable(*(cell + STRIDE))) {
+            fn(tileId + W);
+        }
+        if (walkable(*(cell - 1))) {
+            fn(tileId - 1);
+        }
+        if (walkable(*(cell + 1))) {
+            fn(tileId + 1);
+        }
+    }
+
+    TileKind getKind(size_t tileId) const {
+        const uint8_t code = cells[cellOf(tileId)];
+        return code < MapCodec::OBSTACLE ? TileKind::floor : code == MapCodec::OBSTACLE ? TileKind::obstacle
+            : code == MapCodec::CHARGER ? TileKind::charger : TileKind::unvisited;
+    }
+    // Dirt of a floor tile, 0 for other tiles
+    unsigned int getCleanliness(size_t tileId) const {
+        const uint8_t code = cells[cellOf(tileId)];
+        return code < MapCodec::OBSTACLE ? code : 0;
+    }
+    void clean(size_t tileId, unsigned int efficiency) {
+        uint8_t& code = cells[cellOf(tileId)];
+        if (code < MapCodec::OBSTACLE) {
+            code = efficiency >= code ? 0 : static_cast<uint8_t>(code - efficiency);
+        }
+    }
+
+    // Copies kind and dirt of tileObj; returns false when the tile already matched.
+    // Throws std::runtime_error for a second charger.
+    bool updateTile(size_t tileId, const Tile* tileObj) {
+        if (tileId >= W * H) {
+            throw std::out_of_range("Tile ID out of range");
+        }
+        if (tileObj->getKind() == TileKind::charger && chargerId != Tile::INVALID_ID && chargerId != tileId) {
+            throw std::runtime_error("Map contains more than one charger.");
+        }
+        uint8_t code = MapCodec::UNVISITED;
+        switch (tileObj->getKind()) {
+        case TileKind::floor:
+            code = static_cast<uint8_t>(static_cast<const Floor*>(tileObj)->getCleanliness());
+            break;
+        case TileKind::obstacle:
+            code = MapCodec::OBSTACLE;
+            break;
+        case TileKind::charger:
+            code = MapCodec::CHARGER;
+            chargerId = tileId;
+            break;
+        default:
+            break;
+        }
+        if (cells[cellOf(tileId)] == code) {
+            return false;
+        }
+        if (tileId == chargerId && code != MapCodec::CHARGER) {
+            chargerId = Tile::INVALID_ID;
+        }
+        cells[cellOf(tileId)] = code;
+        return true;
+    }
+};
+
+// Breadth-first distances from source to every tile, UINT32_MAX for unreachable ones.
+// Works on Map and StaticMap; on StaticMap the index arithmetic is folded into constants.
+template <typename Grid, typename Index>
+void breadthFirstDistances(const Grid& grid, size_t source, std::vector<uint32_t>& dist, std::vector<Index>& queue) {
+    dist.assign(grid.getSize(), UINT32_MAX);
+    queue.clear();
+    queue.push_back(static_cast<Index>(source));
+    dist[source] = 0;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const size_t tile = queue[head];
+        grid.forEachWalkableNeighbour(tile, [&](size_t neighbour) {
+            if (dist[neighbour] == UINT32_MAX) {
+                dist[neighbour] = dist[tile] + 1;
+                queue.push_back(static_cast<Index>(neighbour));
+            }
+        });
+    }
+}
+
+// Zarejestrowane plany pięter; nowy rozmiar wystarczy dopisać tutaj
+using StaticPlans = std::tuple<StaticMap<32, 32>, StaticMap<64, 64>, StaticMap<128, 128>>;
+
+// Calls fn with a StaticMap copy of map when its dimensions match a registered plan, with map
+// itself otherwise, and returns its result. fn is a generic lambda, e.g. running breadthFirstDistances.
+template <typename Fn, size_t I = 0>
+auto visitGrid(const Map& map, Fn&& fn) {
+    if constexpr (I == std::tuple_size_v<StaticPlans>) {
+        return fn(map);
+    }
+    else {
+        using Fixed = std::tuple_element_t<I, StaticPlans>;
+        static_assert(std::is_trivially_copyable_v<Fixed>, "StaticMap must stay trivially copyable");
+        if (map.getWidth() == Fixed::WIDTH && map.getHeight() == Fixed::HEIGHT) {
+            const Fixed fixed = Fixed::fromMap(map);
+            return fn(fixed);
+        }
+        return visitGrid<Fn, I + 1>(map, std::forward<Fn>(fn));
+    }
+}
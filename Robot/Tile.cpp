@@ -1,11 +1,12 @@
 #include "Tile.h"
+#include "Floor.h"
 
-Tile::Tile(size_t id) : id(id) {}
+Tile::Tile(TileKind kind) : kind(kind) {}
 
-size_t Tile::getId() const noexcept {
-    return id;
+Floor* Tile::asFloor() noexcept {
+    return isFloor() ? static_cast<Floor*>(this) : nullptr;
 }
 
-void Tile::setId(size_t newId) {
-    id = newId;
+const Floor* Tile::asFloor() const noexcept {
+    return isFloor() ? static_cast<const Floor*>(this) : nullptr;
 }
@@ -1,26 +1,41 @@
 #pragma once
 #include <iostream>
 #include <memory>
+#include <cstdint>
+
+class Floor;
+
+// Rodzaj kafelka - pozwala sprawdzić typ bez dynamic_cast
+enum class TileKind : uint8_t {
+    floor,
+    obstacle,
+    charger,
+    unvisited
+};
 
 class Tile {
 public:
     static constexpr size_t INVALID_ID = SIZE_MAX;
 
 protected:
-    size_t id;
+    TileKind kind;
+
+    // Kafelek nie zna swojego numeru - wynika on z pozycji w mapie, zob. Map::getId
+    explicit Tile(TileKind kind);
 
 public:
-    Tile(size_t id = 0);
     virtual ~Tile() = default;
 
     // Virtual copy constructor
     virtual std::unique_ptr<Tile> clone() const = 0;
 
-    // Getters and setters
-    size_t getId() const noexcept;
-    void setId(size_t newId);
+    // Non-virtual type checks for hot loops
+    TileKind getKind() const noexcept { return kind; }
+    bool isFloor() const noexcept { return kind == TileKind::floor; }
+    bool isWalkable() const noexcept { return kind == TileKind::floor || kind == TileKind::charger; }
+    Floor* asFloor() noexcept;
+    const Floor* asFloor() const noexcept;
 
     // Pure virtual methods
     virtual bool isMoveValid() const = 0;
 };
-
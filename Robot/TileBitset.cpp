@@ -0,0 +1,194 @@
+#include "TileBitset.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    unsigned countTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+    }
+
+    size_t popCount(uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<size_t>(__popcnt64(word));
+#else
+        return static_cast<size_t>(__builtin_popcountll(word));
+#endif
+    }
+
+    // Mask of bits [begin, end) inside one word; end <= 64
+    uint64_t rangeMask(size_t begin, size_t end) {
+        uint64_t high = end >= 64 ? ~uint64_t(0) : (uint64_t(1) << end) - 1;
+        return high & ~((uint64_t(1) << begin) - 1);
+    }
+}
+
+TileBitset::TileBitset(size_t size) {
+    assign(size);
+}
+
+void TileBitset::assign(size_t size) {
+    if (recordingFlips) {
+        if (size != bitCount) {
+            throw std::runtime_error("Bitset can't be resized while a snapshot is open.");
+        }
+        clear();
+        return;
+    }
+    bitCount = size;
+    setCount = 0;
+    words.assign((size + WORD_BITS - 1) / WORD_BITS, 0);
+    dirtyWords.assign((words.size() + WORD_BITS - 1) / WORD_BITS, 0);
+}
+
+void TileBitset::clear() {
+    if (recordingFlips) {
+        for (size_t index = findNext(0); index != npos; index = findNext(index + 1)) {
+            flipLog.push_back(static_cast<TileIndex>(index));
+        }
+    }
+    // Zeruje tylko słowa oznaczone jako brudne
+    for (size_t d = 0; d < dirtyWords.size(); ++d) {
+        uint64_t mask = dirtyWords[d];
+        while (mask) {
+            words[d * WORD_BITS + countTrailingZeros(mask)] = 0;
+            mask &= mask - 1;
+        }
+        dirtyWords[d] = 0;
+    }
+    setCount = 0;
+}
+
+void TileBitset::markDirty(size_t word) {
+    dirtyWords[word / WORD_BITS] |= uint64_t(1) << (word % WORD_BITS);
+}
+
+void TileBitset::set(size_t index, bool value) {
+    const size_t word = index / WORD_BITS;
+    const uint64_t bit = uint64_t(1) << (index % WORD_BITS);
+    const bool current = (words[word] & bit) != 0;
+    if (current == value) {
+        return;
+    }
+    if (recordingFlips) {
+        flipLog.push_back(static_cast<TileIndex>(index));
+    }
+    if (value) {
+        words[word] |= bit;
+        markDirty(word);
+        setCount++;
+    }
+    else {
+        words[word] &= ~bit;
+        setCount--;
+    }
+}
+
+size_t TileBitset::findNext(size_t from) const {
+    if (from >= bitCount || setCount == 0) {
+        return npos;
+    }
+
+    size_t word = from / WORD_BITS;
+    uint64_t bits = words[word] & ~((uint64_t(1) << (from % WORD_BITS)) - 1);
+    if (bits) {
+        return word * WORD_BITS + countTrailingZeros(bits);
+    }
+
+    // Dalej szukamy tylko wśród brudnych słów
+    size_t next = word + 1;
+    for (size_t d = next / WORD_BITS; d < dirtyWords.size(); ++d) {
+        uint64_t mask = dirtyWords[d];
+        if (d == next / WORD_BITS) {
+            mask &= ~((uint64_t(1) << (next % WORD_BITS)) - 1);
+        }
+        while (mask) {
+            const size_t candidate = d * WORD_BITS + countTrailingZeros(mask);
+            if (words[candidate]) {
+                return candidate * WORD_BITS + countTrailingZeros(words[candidate]);
+            }
+            mask &= mask - 1;
+        }
+    }
+    return npos;
+}
+
+size_t TileBitset::countRange(size_t begin, size_t end) const {
+    end = std::min(end, bitCount);
+    if (begin >= end) {
+        return 0;
+    }
+
+    const size_t firstWord = begin / WORD_BITS;
+    const size_t lastWord = (end - 1) / WORD_BITS;
+    if (firstWord == lastWord) {
+        return popCount(words[firstWord] & rangeMask(begin % WORD_BITS, end - firstWord * WORD_BITS));
+    }
+
+    size_t result = popCount(words[firstWord] & rangeMask(begin % WORD_BITS, WORD_BITS));
+    for (size_t w = firstWord + 1; w < lastWord; ++w) {
+        result += popCount(words[w]);
+    }
+    result += popCount(words[lastWord] & rangeMask(0, end - lastWord * WORD_BITS));
+    return result;
+}
+
+void TileBitset::collectNear(size_t center, size_t radius, size_t width, std::vector<size_t>& out) const {
+    if (width == 0 || center >= bitCount || setCount == 0) {
+        return;
+    }
+
+    const size_t height = (bitCount + width - 1) / width;
+    const size_t row = center / width;
+    const size_t col = center % width;
+    const size_t firstRow = row > radius ? row - radius : 0;
+    const size_t lastRow = std::min(height - 1, row + std::min(radius, height));
+    const size_t firstCol = col > radius ? col - radius : 0;
+    const size_t lastCol = std::min(width - 1, col + std::min(radius, width));
+
+    for (size_t r = firstRow; r <= lastRow; ++r) {
+        const size_t begin = r * width + firstCol;
+        const size_t end = std::min(r * width + lastCol + 1, bitCount);
+        for (size_t w = begin / WORD_BITS; w * WORD_BITS < end; ++w) {
+            const size_t wordBegin = w * WORD_BITS;
+            uint64_t bits = words[w] & rangeMask(begin > wordBegin ? begin - wordBegin : 0,
+                std::min(end - wordBegin, WORD_BITS));
+            while (bits) {
+                out.push_back(wordBegin + countTrailingZeros(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+size_t TileBitset::snapshot() {
+    recordingFlips = true;
+    return flipLog.size();
+}
+
+void TileBitset::rollback(size_t snapshot) {
+    if (!recordingFlips || snapshot > flipLog.size()) {
+        throw std::runtime_error("Bitset snapshot no longer exists.");
+    }
+    recordingFlips = false;
+    while (flipLog.size() > snapshot) {
+        const size_t index = flipLog.back();
+        flipLog.pop_back();
+        set(index, !test(index));
+    }
+    recordingFlips = true;
+}
+
+void TileBitset::commit() noexcept {
+    flipLog.clear();
+    recordingFlips = false;
+}
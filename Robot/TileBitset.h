@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TileIndex.h"
+
+// Zbiór kafelków upakowany po 64 bity w słowie.
+// Drugi poziom bitów zapamiętuje niezerowe słowa, więc czyszczenie
+// i wyszukiwanie pomijają puste fragmenty mapy.
+class TileBitset {
+public:
+    static constexpr size_t npos = SIZE_MAX;
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> dirtyWords; // Bit i - słowo i mogło zostać ustawione
+    size_t bitCount = 0;
+    size_t setCount = 0;
+    std::vector<TileIndex> flipLog;   // Bits changed since the oldest snapshot
+    bool recordingFlips = false;
+
+    void markDirty(size_t word);
+
+public:
+    TileBitset() = default;
+    explicit TileBitset(size_t size);
+
+    // Resizes and clears all bits; with a snapshot open the size can't change
+    void assign(size_t size);
+    void clear();
+
+    size_t size() const noexcept { return bitCount; }
+    size_t count() const noexcept { return setCount; }
+    bool any() const noexcept { return setCount != 0; }
+    bool none() const noexcept { return setCount == 0; }
+
+    bool test(size_t index) const noexcept {
+        return (words[index / WORD_BITS] >> (index % WORD_BITS)) & 1u;
+    }
+    bool operator[](size_t index) const noexcept { return test(index); }
+    void set(size_t index, bool value = true);
+    void reset(size_t index) { set(index, false); }
+
+    // First set bit at or after from, npos if none
+    size_t findNext(size_t from) const;
+    // Set bits in [begin, end)
+    size_t countRange(size_t begin, size_t end) const;
+    // Set bits inside the square of the given radius around center on a grid of the given width
+    void collectNear(size_t center, size_t radius, size_t width, std::vector<size_t>& out) const;
+
+    // Snapshot for lookahead, same as Map::snapshot: changed bits are logged until commit
+    size_t snapshot();
+    void rollback(size_t snapshot);
+    void commit() noexcept;
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Typ identyfikatorów kafelków w tablicach planowania: rodzice i kolejki wyszukiwań, składowe mapy,
+// dziennik cofania. Domyślnie 32 bity, czyli połowa pamięci przeglądanej przez każde BFS;
+// ROBOT_TILE_INDEX_64 przywraca size_t. Publiczne API nadal przyjmuje i zwraca size_t.
+#ifdef ROBOT_TILE_INDEX_64
+using TileIndex = size_t;
+#else
+using TileIndex = uint32_t;
+#endif
+
+// Najwyższa wartość oznacza brak kafelka, więc mapa może mieć o jeden kafelek mniej
+constexpr TileIndex NO_TILE = std::numeric_limits<TileIndex>::max();
+constexpr size_t MAX_TILE_COUNT = NO_TILE;
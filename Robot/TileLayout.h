@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+
+// Kolejność kafelków wewnątrz kawałka mapy (kwadrat side x side, side potęgą dwójki do 256).
+// Map bierze układ wybrany przy kompilacji (ROBOT_MAP_MORTON), identyfikatory kafelków zostają wierszami.
+struct RowMajorLayout {
+    static constexpr const char* NAME = "row-major";
+    static constexpr size_t slot(size_t x, size_t y, size_t side) noexcept { return y * side + x; }
+};
+
+// Z-order: bity x i y na przemian, więc kafelek nad i pod leży zwykle kilka miejsc dalej, a nie cały wiersz
+struct MortonLayout {
+    static constexpr const char* NAME = "morton";
+    static constexpr size_t spread(size_t v) noexcept {
+        v = (v | (v << 4)) & 0x0F0F;
+        v = (v | (v << 2)) & 0x3333;
+        return (v | (v << 1)) & 0x5555;
+    }
+    static constexpr size_t slot(size_t x, size_t y, size_t) noexcept { return spread(x) | (spread(y) << 1); }
+};
+
+#ifdef ROBOT_MAP_MORTON
+using MapTileLayout = MortonLayout;
+#else
+using MapTileLayout = RowMajorLayout;
+#endif
@@ -1,6 +1,6 @@
 #include "UnVisited.h"
 
-UnVisited::UnVisited(size_t id) : Tile(id) {}
+UnVisited::UnVisited() : Tile(TileKind::unvisited) {}
 
 std::unique_ptr<Tile> UnVisited::clone() const {
     return std::make_unique<UnVisited>(*this);
@@ -3,7 +3,7 @@
 
 class UnVisited : public Tile {
 public:
-    UnVisited(size_t id = 0);
+    UnVisited();
 
     // Virtual copy constructor
     std::unique_ptr<Tile> clone() const override;
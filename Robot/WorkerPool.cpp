@@ -0,0 +1,86 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::stop() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+}
+
+void WorkerPool::workerLoop(unsigned worker, uint64_t seen) {
+    for (;;) {
+        const Job* current = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            current = worker < jobWorkers ? job : nullptr;
+        }
+        // Wątki ponad liczbę wykonawców bieżącego zadania tylko czekają na następne
+        std::exception_ptr error;
+        if (current) {
+            try {
+                (*current)(worker);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error && !failure) {
+            failure = error;
+        }
+        if (--running == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void WorkerPool::run(unsigned workers, const Job& task) {
+    std::lock_guard<std::mutex> runLock(runMutex);
+    // Brakujące wątki; błąd tworzenia zostawia pulę mniejszą, a destruktor dołącza utworzone
+    while (threads.size() + 1 < workers) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, static_cast<unsigned>(threads.size() + 1), generation);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &task;
+        jobWorkers = std::min<unsigned>(workers, static_cast<unsigned>(threads.size() + 1));
+        running = static_cast<unsigned>(threads.size());
+        failure = nullptr;
+        generation++;
+    }
+    wake.notify_all();
+
+    std::exception_ptr error;
+    try {
+        task(0);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return running == 0; });
+    job = nullptr;
+    if (!error) {
+        error = failure;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Stałe wątki wykonujące jedno zadanie naraz, zamiast tworzenia wątków przy każdym wywołaniu.
+// Wątki startują przy pierwszym run(); wywołania z wielu wątków wykonują się po kolei.
+class WorkerPool {
+public:
+    using Job = std::function<void(unsigned worker)>;
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex runMutex;                    // One job at a time
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const Job* job = nullptr;
+    unsigned jobWorkers = 0;
+    uint64_t generation = 0;
+    unsigned running = 0;
+    bool stopping = false;
+    std::exception_ptr failure;
+
+    void workerLoop(unsigned worker, uint64_t seen);
+    void stop() noexcept;
+
+public:
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    ~WorkerPool();
+
+    // Calls job(0) on the calling thread and job(1) .. job(workers - 1) on pool threads, started
+    // on first use. Returns when all calls have finished and rethrows the first exception.
+    void run(unsigned workers, const Job& job);
+    unsigned threadCount() const noexcept { return static_cast<unsigned>(threads.size()); }
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <chrono>
+#include <ctime>
+#include <cstddef>
+#include <fstream>
+#include <random>
+#include <string>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace BenchUtils {
+    // Generates an office-like floor plan: outer walls, a grid of rooms with door gaps,
+    // scattered furniture and a single charger near the top-left corner.
+    // Furniture and dirt densities are given in tenths of a percent.
+    inline std::string generateOfficeMap(size_t width, size_t height, unsigned seed = 1,
+        int furniturePerMille = 20, int dirtPerMille = 50) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> perMille(0, 999);
+        std::uniform_int_distribution<int> dirt(1, 9);
+        const size_t roomSize = 24;
+
+        std::string map;
+        map.reserve((width + 1) * height);
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                bool border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+                bool wall = (x % roomSize == 0 && y % roomSize != roomSize / 2)
+                    || (y % roomSize == 0 && x % roomSize != roomSize / 2);
+                char tile = '0';
+                if (border || wall) {
+                    tile = 'P';
+                }
+                else if (perMille(gen) < furniturePerMille) {
+                    tile = 'P';
+                }
+                else if (perMille(gen) < dirtPerMille) {
+                    tile = static_cast<char>('0' + dirt(gen));
+                }
+                if (x == 1 && y == 1) {
+                    tile = 'B';
+                }
+                map += tile;
+            }
+            map += '\n';
+        }
+        return map;
+    }
+
+    // CPU time used by the calling thread in milliseconds; wall-clock time where not available
+    inline double threadCpuMs() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+#else
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    // Resident memory of the process in KiB; 0 where it can't be read
+    inline size_t residentKiB() {
+#if defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        size_t pages = 0;
+        size_t resident = 0;
+        if (statm >> pages >> resident) {
+            return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+        }
+#endif
+        return 0;
+    }
+
+    // Returns the best wall-clock time of repeats runs, in milliseconds
+    template <typename Fn>
+    double bestOf(int repeats, Fn&& fn) {
+        double best = 1e300;
+        for (int i = 0; i < repeats; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            best = elapsed.count() < best ? elapsed.count() : best;
+        }
+        return best;
+    }
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchUtils.h"
+#include "Robot.h"
+#include "CoveragePlanner.h"
+
+// Runs a whole-map cleaning order on a robot that already knows the map and
+// reports route length, how many tiles it drove over and the planning time.
+int main(int argc, char* argv[]) {
+    size_t width = 128;
+    size_t height = 128;
+    if (argc == 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+
+    std::string text = BenchUtils::generateOfficeMap(width, height, 3);
+    std::istringstream mapStream(text);
+    Map world(mapStream);
+
+    std::string save = text + "\n" + std::to_string(world.getChargerId()) + " "
+        + std::to_string(world.getChargerId()) + " 1 0 " + std::to_string(world.getSize());
+    for (size_t i = 0; i < world.getSize(); ++i) {
+        save += " 0";
+    }
+    save += " 0\n";
+    std::istringstream robotStream(save);
+    Robot robot(robotStream);
+
+    CoveragePlanner planner(robot.getMemoryMap());
+    double planStart = BenchUtils::threadCpuMs();
+    std::vector<size_t> route = planner.plan(robot.getPosition());
+    double planMs = BenchUtils::threadCpuMs() - planStart;
+
+    double orderStart = BenchUtils::threadCpuMs();
+    robot.orderToCleanEfficiently();
+    double orderMs = BenchUtils::threadCpuMs() - orderStart;
+
+    std::vector<bool> visited(world.getSize(), false);
+    size_t steps = 0;
+    size_t moves = 0;
+    double stepMs = 0;
+    for (; steps < world.getSize() * 8; ++steps) {
+        size_t position = robot.getPosition();
+        visited[position] = true;
+        robot.exploreTile(position, world.getTile(position));
+        for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+            if (auto neighbour = world.getIndex(position, dir)) {
+                robot.exploreTile(*neighbour, world.getTile(*neighbour));
+            }
+        }
+
+        double stepStart = BenchUtils::threadCpuMs();
+        RobotStep step = robot.step();
+        stepMs += BenchUtils::threadCpuMs() - stepStart;
+        if (step.action == RobotAction::none || step.error != RobotError::none) {
+            break;
+        }
+        if (step.action == RobotAction::move) {
+            moves++;
+        }
+        else if (step.action == RobotAction::clean) {
+            world.editFloor(robot.getPosition())->getCleaned(robot.getCleaningEfficiency());
+        }
+    }
+
+    size_t visitedCount = 0;
+    for (bool v : visited) {
+        visitedCount += v;
+    }
+
+    std::cout << "Office map " << width << "x" << height << "\n\n" << std::fixed << std::setprecision(2)
+        << "cells                  " << planner.getCells().size() << "\n"
+        << "planner searches       " << planner.getSearchCount() << "\n"
+        << "planned route          " << route.size() << " tiles in " << planMs << " ms\n"
+        << "orderToCleanEfficiently " << orderMs << " ms\n"
+        << "run until done         " << steps << " steps, " << moves << " moves, " << visitedCount
+        << " tiles visited, " << stepMs << " ms in step()\n";
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchUtils.h"
+#include "Robot.h"
+
+namespace {
+    std::vector<size_t> randomWalkable(const Map& map, size_t count, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> tile(0, map.getSize() - 1);
+        std::vector<size_t> tiles;
+        while (tiles.size() < count) {
+            size_t id = tile(gen);
+            if (map.canMoveOn(id)) {
+                tiles.push_back(id);
+            }
+        }
+        return tiles;
+    }
+
+    // Walkable tiles of the square of the given radius around center
+    std::vector<size_t> nearby(const Map& map, size_t center, size_t radius, size_t count) {
+        std::vector<size_t> tiles;
+        const size_t width = map.getWidth();
+        const size_t cx = center % width, cy = center / width;
+        for (size_t y = cy > radius ? cy - radius : 0; y <= cy + radius && y < map.getHeight() && tiles.size() < count; ++y) {
+            for (size_t x = cx > radius ? cx - radius : 0; x <= cx + radius && x < width && tiles.size() < count; ++x) {
+                if (map.canMoveOn(y * width + x)) {
+                    tiles.push_back(y * width + x);
+                }
+            }
+        }
+        return tiles;
+    }
+
+    void row(const char* name, const Map& map, const std::vector<size_t>& sources, const std::vector<size_t>& targets, unsigned threads) {
+        size_t visited = 0;
+        double ms = BenchUtils::bestOf(3, [&] {
+            visited = map.distances(sources, targets, threads).getVisitedTiles();
+        });
+        std::cout << std::left << std::setw(34) << name << std::right << std::setw(8) << sources.size() << std::setw(8) << targets.size()
+            << std::setw(9) << threads << std::setw(12) << visited << std::setw(11) << std::fixed << std::setprecision(1) << ms << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 2048;
+    size_t height = 2048;
+    size_t targetCount = 10000;
+    if (argc >= 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+    if (argc >= 4) {
+        targetCount = std::stoul(argv[3]);
+    }
+
+    std::istringstream mapStream(BenchUtils::generateOfficeMap(width, height));
+    Map map(mapStream);
+    const std::vector<size_t> targets = randomWalkable(map, targetCount, 2);
+    const std::vector<size_t> fewSources = randomWalkable(map, 16, 3);
+    const std::vector<size_t> charger{ map.getChargerId() };
+
+    std::cout << "Office map " << width << "x" << height << "\n\n";
+    std::cout << "case                               sources targets  threads     visited         ms\n";
+    row("charger -> all targets", map, charger, targets, 1);
+    row("16 sources -> all targets", map, fewSources, targets, 1);
+    row("16 sources -> all targets", map, fewSources, targets, 4);
+    row("charger -> 500 targets nearby", map, charger, nearby(map, map.getChargerId(), 40, 500), 1);
+
+    // Dotychczasowy sposób: osobne planowanie trasy robota do każdego celu
+    Robot robot(map.getWidth(), map.getHeight(), map.getChargerId());
+    for (size_t id = 0; id < map.getSize(); ++id) {
+        robot.exploreTile(id, map.getTile(id));
+    }
+    const size_t sample = std::min<size_t>(20, targets.size());
+    double ms = BenchUtils::bestOf(1, [&] {
+        for (size_t i = 0; i < sample; ++i) {
+            robot.setPosition(map.getChargerId());
+            robot.orderToMove(targets[i]);
+        }
+    });
+    std::cout << "\norderToMove per target: " << std::setprecision(2) << ms / sample << " ms, "
+        << std::setprecision(0) << ms / sample * targets.size() << " ms estimated for " << targets.size() << " targets\n";
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include "BenchUtils.h"
+#include "Fleet.h"
+
+namespace {
+    unsigned int totalDirt(const Map& map) {
+        unsigned int dirt = 0;
+        for (size_t i = 0; i < map.getSize(); ++i) {
+            if (const Floor* floor = map.getTile(i)->asFloor()) {
+                dirt += floor->getCleanliness();
+            }
+        }
+        return dirt;
+    }
+
+    template <typename T>
+    uint64_t sum(const std::vector<T>& values) {
+        return std::accumulate(values.begin(), values.end(), uint64_t{ 0 });
+    }
+
+    // Runs robotCount robots spread over the map, all starting with the whole map in memory
+    void runFleet(const std::string& mapText, size_t robotCount, size_t maxTicks, bool share) {
+        std::istringstream mapStream(mapText);
+        Map world(mapStream);
+        const unsigned int dirtBefore = totalDirt(world);
+
+        Robot prototype(world.getWidth(), world.getHeight(), world.getChargerId());
+        for (size_t id = 0; id < world.getSize(); ++id) {
+            prototype.exploreTile(id, world.getTile(id));
+        }
+
+        Fleet::Options options;
+        options.shareDiscovery = share;
+        Fleet fleet(world, options);
+        const size_t stride = world.getSize() / robotCount;
+        for (size_t tile = 0; fleet.size() < robotCount && tile < world.getSize(); tile += stride) {
+            size_t position = tile;
+            while (position < world.getSize() && !world.canMoveOn(position)) {
+                position++;
+            }
+            if (position < world.getSize()) {
+                Robot robot = prototype;
+                robot.setPosition(position);
+                try {
+                    fleet.addRobot(std::move(robot));
+                }
+                catch (const std::runtime_error&) {
+                    // Tile already taken - skip it
+                }
+            }
+        }
+
+        double cpuStart = BenchUtils::threadCpuMs();
+        size_t ticks = fleet.run(maxTicks);
+        double cpuMs = BenchUtils::threadCpuMs() - cpuStart;
+
+        const FleetMetrics& metrics = fleet.getMetrics();
+        const uint64_t robotSteps = sum(metrics.moves) + sum(metrics.cleans) + sum(metrics.waits) + sum(metrics.idleTicks);
+        std::cout << std::left << std::setw(8) << (share ? "shared" : "own") << std::right << std::setw(7) << fleet.size()
+            << std::setw(7) << ticks << std::setw(10) << std::fixed << std::setprecision(1) << cpuMs << std::setw(12) << std::setprecision(0) << robotSteps / (cpuMs / 1e3)
+            << std::setw(9) << sum(metrics.moves) << std::setw(8) << sum(metrics.waits) << std::setw(7) << sum(metrics.sidesteps)
+            << std::setw(9) << sum(metrics.dirtCleaned) << "/" << dirtBefore << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 128;
+    size_t height = 128;
+    size_t robotCount = 100;
+    size_t maxTicks = 2000;
+    if (argc >= 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+    if (argc >= 4) {
+        robotCount = std::stoul(argv[3]);
+    }
+    if (argc >= 5) {
+        maxTicks = std::stoul(argv[4]);
+    }
+
+    std::string mapText = BenchUtils::generateOfficeMap(width, height);
+    std::cout << "Office map " << width << "x" << height << ", up to " << robotCount << " robots, " << maxTicks << " ticks\n\n";
+    std::cout << "memory   robots  ticks    cpu ms     steps/s    moves   waits  sides  cleaned\n";
+    for (bool share : { false, true }) {
+        runFleet(mapText, robotCount, maxTicks, share);
+    }
+    return 0;
+}
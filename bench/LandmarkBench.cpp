@@ -0,0 +1,84 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchUtils.h"
+#include "Robot.h"
+
+namespace {
+    Robot knownRobot(const Map& map) {
+        Robot robot(map.getWidth(), map.getHeight(), map.getChargerId());
+        for (size_t id = 0; id < map.getSize(); ++id) {
+            robot.exploreTile(id, map.getTile(id));
+        }
+        return robot;
+    }
+
+    // Average time of orderToMove between the given pairs of tiles
+    double routeMs(Robot& robot, const std::vector<std::pair<size_t, size_t>>& queries, size_t& steps) {
+        steps = 0;
+        double ms = BenchUtils::bestOf(1, [&] {
+            for (const auto& [from, to] : queries) {
+                robot.setPosition(from);
+                robot.orderToMove(to);
+                steps += robot.getPath().size();
+            }
+        });
+        return ms / queries.size();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 2048;
+    size_t height = 2048;
+    size_t queryCount = 20;
+    if (argc >= 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+    if (argc >= 4) {
+        queryCount = std::stoul(argv[3]);
+    }
+
+    std::istringstream mapStream(BenchUtils::generateOfficeMap(width, height));
+    Map map(mapStream);
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<size_t> tile(0, map.getSize() - 1);
+    std::vector<std::pair<size_t, size_t>> queries;
+    while (queries.size() < queryCount) {
+        size_t from = tile(gen), to = tile(gen);
+        if (map.canMoveOn(from) && map.canMoveOn(to) && map.isReachable(from, to)) {
+            queries.emplace_back(from, to);
+        }
+    }
+
+    std::cout << "Office map " << width << "x" << height << ", " << queryCount << " random reachable routes\n\n";
+    Robot plain = knownRobot(map);
+    size_t plainSteps = 0;
+    const double plainMs = routeMs(plain, queries, plainSteps);
+    std::cout << "breadth-first        " << std::fixed << std::setprecision(2) << std::setw(10) << plainMs << " ms/route\n";
+
+    for (size_t count : { 4, 8, 16 }) {
+        std::shared_ptr<const LandmarkTable> table;
+        double buildMs = BenchUtils::bestOf(1, [&] {
+            table = std::make_shared<const LandmarkTable>(LandmarkTable::build(map, count));
+        });
+        std::stringstream file;
+        double saveMs = BenchUtils::bestOf(1, [&] { table->save(file); });
+        LandmarkTable loaded;
+        double loadMs = BenchUtils::bestOf(1, [&] { loaded.load(file); });
+
+        Robot guided = knownRobot(map);
+        guided.setLandmarks(table);
+        size_t steps = 0;
+        const double ms = routeMs(guided, queries, steps);
+        std::cout << "A* " << std::setw(2) << count << " landmarks     " << std::setw(10) << ms << " ms/route"
+            << (steps == plainSteps ? "" : "  ROUTE LENGTHS DIFFER")
+            << "   build " << std::setprecision(0) << buildMs << " ms, file " << file.str().size() / (1 << 20)
+            << " MiB, save " << saveMs << " ms, load " << loadMs << " ms\n" << std::setprecision(2);
+    }
+    return 0;
+}
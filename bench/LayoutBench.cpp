@@ -0,0 +1,136 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "BenchUtils.h"
+#include "Robot.h"
+#include "StaticMap.h"
+
+namespace {
+    // Same neighbour walk as CleaningStrategy::searchFrom; returns the number of reached tiles
+    size_t breadthFirst(const Map& map, size_t start, std::vector<size_t>& parent, std::vector<size_t>& queue) {
+        parent.assign(map.getSize(), SIZE_MAX);
+        queue.clear();
+        parent[start] = start;
+        queue.push_back(start);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const size_t current = queue[head];
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                auto neighbour = map.getIndex(current, dir);
+                if (neighbour.has_value() && parent[*neighbour] == SIZE_MAX && map.canMoveOn(*neighbour)) {
+                    parent[*neighbour] = current;
+                    queue.push_back(*neighbour);
+                }
+            }
+        }
+        return queue.size();
+    }
+
+    size_t breadthFirstNeighbours(const Map& map, size_t start, std::vector<size_t>& parent, std::vector<size_t>& queue) {
+        parent.assign(map.getSize(), SIZE_MAX);
+        queue.clear();
+        parent[start] = start;
+        queue.push_back(start);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const size_t current = queue[head];
+            map.forEachWalkableNeighbour(current, [&](size_t neighbour) {
+                if (parent[neighbour] == SIZE_MAX) {
+                    parent[neighbour] = current;
+                    queue.push_back(neighbour);
+                }
+            });
+        }
+        return queue.size();
+    }
+
+    void row(const char* name, size_t tiles, double ms) {
+        std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << ms << " ms" << std::setw(10) << tiles / ms / 1000.0 << " Mtiles/s\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 8192;
+    size_t height = 1024;
+    if (argc >= 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+
+    std::istringstream mapStream(BenchUtils::generateOfficeMap(width, height));
+    Map map(mapStream);
+    std::cout << "Office map " << width << "x" << height << ", " << Map::Layout::NAME << " chunk layout\n\n";
+
+    std::vector<size_t> parent;
+    std::vector<size_t> queue;
+    queue.reserve(map.getSize());
+    size_t reached = 0;
+    double ms = BenchUtils::bestOf(3, [&] { reached = breadthFirst(map, map.getChargerId(), parent, queue); });
+    row("BFS getIndex + canMoveOn", reached, ms);
+    ms = BenchUtils::bestOf(3, [&] { reached = breadthFirstNeighbours(map, map.getChargerId(), parent, queue); });
+    row("BFS forEachWalkableNeighbour", reached, ms);
+
+    // Najdalszy osiągalny kafelek jako jedyny cel - wyszukiwanie przechodzi całą składową
+    const std::vector<size_t> sources{ map.getChargerId() };
+    const std::vector<size_t> targets{ queue.back() };
+    ms = BenchUtils::bestOf(3, [&] { reached = map.distances(sources, targets).getVisitedTiles(); });
+    row("BFS Map::distances", reached, ms);
+
+    size_t walkable = 0;
+    ms = BenchUtils::bestOf(3, [&] {
+        walkable = 0;
+        for (size_t id = 0; id < map.getSize(); ++id) {
+            walkable += map.canMoveOn(id);
+        }
+    });
+    row("canMoveOn by rows", map.getSize(), ms);
+    ms = BenchUtils::bestOf(3, [&] {
+        walkable = 0;
+        for (size_t x = 0; x < width; ++x) {
+            for (size_t id = x; id < map.getSize(); id += width) {
+                walkable += map.canMoveOn(id);
+            }
+        }
+    });
+    row("canMoveOn by columns", map.getSize(), ms);
+
+    // Stały plan piętra: ta sama funkcja BFS i kopia całej mapy, jak przy rozgałęzianiu symulacji
+    std::istringstream planStream(BenchUtils::generateOfficeMap(128, 128));
+    const Map plan(planStream);
+    const size_t repeats = 200;
+    std::vector<uint32_t> dist;
+    std::cout << "\nOffice map 128x128, " << repeats << " repetitions\n";
+    auto bfsRow = [&](const char* name, const auto& grid) {
+        double total = BenchUtils::bestOf(3, [&] {
+            for (size_t i = 0; i < repeats; ++i) {
+                breadthFirstDistances(grid, grid.getChargerId(), dist, queue);
+            }
+        });
+        row(name, queue.size() * repeats, total);
+    };
+    bfsRow("BFS Map", plan);
+    std::vector<Map> mapCopies(repeats);
+    ms = BenchUtils::bestOf(3, [&] {
+        for (Map& copy : mapCopies) {
+            copy = plan;
+        }
+    });
+    row("copy Map", plan.getSize() * repeats, ms);
+    visitGrid(plan, [&](const auto& fixedPlan) {
+        bfsRow("BFS StaticMap", fixedPlan);
+        std::vector<std::decay_t<decltype(fixedPlan)>> fixedCopies(repeats);
+        ms = BenchUtils::bestOf(3, [&] {
+            for (auto& copy : fixedCopies) {
+                copy = fixedPlan;
+            }
+        });
+        row("copy StaticMap", plan.getSize() * repeats, ms);
+        for (size_t i = 0; i < repeats; ++i) {
+            walkable += mapCopies[i].canMoveOn(i) + fixedCopies[i].canMoveOn(i);
+        }
+    });
+    std::cout << "(" << walkable << " walkable tiles sampled)\n";
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BenchUtils.h"
+#include "Map.h"
+#include "MapCodec.h"
+
+namespace {
+    const MapCodec::Kernel ALL_KERNELS[] = { MapCodec::Kernel::scalar, MapCodec::Kernel::sse2, MapCodec::Kernel::avx2 };
+
+    void printRow(const std::string& name, double ms, double megabytes) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << ms << " ms" << std::setw(10) << megabytes / (ms / 1000.0) << " MB/s\n";
+    }
+
+    void benchCodec(const std::string& text, size_t width, size_t height) {
+        double megabytes = static_cast<double>(width * height) / (1024.0 * 1024.0);
+        std::vector<uint8_t> codes(width * height);
+        std::string encoded(width, ' ');
+
+        std::cout << "\nRow codec (" << width << "x" << height << "):\n";
+        for (MapCodec::Kernel kernel : ALL_KERNELS) {
+            if (!MapCodec::isKernelSupported(kernel)) {
+                continue;
+            }
+            MapCodec::setKernel(kernel);
+            double decodeMs = BenchUtils::bestOf(5, [&]() {
+                for (size_t y = 0; y < height; ++y) {
+                    MapCodec::decodeRow(text.data() + y * (width + 1), width, codes.data() + y * width, false);
+                }
+            });
+            double encodeMs = BenchUtils::bestOf(5, [&]() {
+                for (size_t y = 0; y < height; ++y) {
+                    MapCodec::encodeRow(codes.data() + y * width, width, &encoded[0]);
+                }
+            });
+            printRow(std::string("decode ") + MapCodec::kernelName(kernel), decodeMs, megabytes);
+            printRow(std::string("encode ") + MapCodec::kernelName(kernel), encodeMs, megabytes);
+        }
+    }
+
+    void benchMapIo(const std::string& text, size_t width, size_t height) {
+        double megabytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+
+        std::cout << "\nMap::loadMap / Map::saveMap (" << width << "x" << height << "):\n";
+        for (MapCodec::Kernel kernel : ALL_KERNELS) {
+            if (!MapCodec::isKernelSupported(kernel)) {
+                continue;
+            }
+            MapCodec::setKernel(kernel);
+            Map map;
+            double loadMs = BenchUtils::bestOf(3, [&]() {
+                std::istringstream in(text);
+                map.loadMap(in);
+            });
+            double saveMs = BenchUtils::bestOf(3, [&]() {
+                std::ostringstream out;
+                map.saveMap(out);
+            });
+            printRow(std::string("loadMap ") + MapCodec::kernelName(kernel), loadMs, megabytes);
+            printRow(std::string("saveMap ") + MapCodec::kernelName(kernel), saveMs, megabytes);
+        }
+    }
+
+    void benchRle(const std::string& name, const std::string& text, size_t width, size_t height) {
+        Map map;
+        std::istringstream textStream(text);
+        map.loadMap(textStream);
+        std::ostringstream rleStream;
+        map.saveMap(rleStream, MapFormat::rle);
+        std::string rle = rleStream.str();
+
+        double textMs = BenchUtils::bestOf(3, [&]() {
+            std::istringstream in(text);
+            map.loadMap(in);
+        });
+        double rleMs = BenchUtils::bestOf(3, [&]() {
+            std::istringstream in(rle);
+            map.loadMap(in);
+        });
+
+        std::cout << "\nRLE format, " << name << " (" << width << "x" << height << "):\n";
+        std::cout << "  text " << text.size() / 1024 << " KiB, rle " << rle.size() / 1024 << " KiB, ratio "
+            << std::fixed << std::setprecision(1) << static_cast<double>(text.size()) / rle.size() << "x\n";
+        std::cout << "  loadMap text " << std::setprecision(2) << textMs << " ms, rle " << rleMs << " ms\n";
+    }
+
+    // Pamięć robota w dużym, prawie nieznanym budynku: kawałki powstają dopiero przy zapisie
+    void benchRobotMemory(size_t side, size_t explored) {
+        std::cout << "\nRobot memory " << side << "x" << side << ", explored " << explored << "x" << explored << ":\n";
+        Map memory;
+        const size_t residentBefore = BenchUtils::residentKiB();
+        double createMs = BenchUtils::bestOf(1, [&] { memory = Map(side, side, 0); });
+        const size_t residentCreated = BenchUtils::residentKiB();
+        Floor floor;
+        double exploreMs = BenchUtils::bestOf(1, [&] {
+            for (size_t y = 0; y < explored; ++y) {
+                for (size_t x = 0; x < explored; ++x) {
+                    memory.updateTile(y * side + x, &floor);
+                }
+            }
+        });
+        const size_t residentExplored = BenchUtils::residentKiB();
+        std::stringstream saved;
+        double saveMs = BenchUtils::bestOf(1, [&] { memory.saveMap(saved, MapFormat::rle); });
+        double componentsMs = BenchUtils::bestOf(1, [&] { memory.getComponent(0); });
+        std::cout << "  create " << std::setprecision(2) << createMs << " ms, explore " << exploreMs << " ms, components "
+            << componentsMs << " ms, save rle " << saveMs << " ms\n";
+        std::cout << "  chunks " << memory.getLoadedChunkCount() << " of " << memory.getChunkCount() << " created\n";
+        std::cout << "  resident +" << (static_cast<double>(residentCreated) - residentBefore) / 1024 << " MiB after create, +"
+            << (static_cast<double>(residentExplored) - residentBefore) / 1024 << " MiB after explore\n";
+    }
+
+    // Wczytanie, ponowne wczytanie i zniszczenie dużej mapy: własna pula mapy albo alokacja każdego kafelka z osobna
+    void benchTileAllocation(size_t side) {
+        const std::string text = BenchUtils::generateOfficeMap(side, side);
+        std::cout << "\nTile allocation, " << side << "x" << side << ":\n";
+        const std::pair<const char*, std::pmr::memory_resource*> allocators[] = {
+            { "map pool", nullptr }, { "new/delete", std::pmr::new_delete_resource() } };
+        for (const auto& [name, resource] : allocators) {
+            double loadMs = 1e300, reloadMs = 1e300, destroyMs = 1e300;
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                auto map = std::make_unique<Map>(resource);
+                std::istringstream first(text);
+                loadMs = std::min(loadMs, BenchUtils::bestOf(1, [&] { map->loadMap(first); }));
+                std::istringstream second(text);
+                reloadMs = std::min(reloadMs, BenchUtils::bestOf(1, [&] { map->loadMap(second); }));
+                destroyMs = std::min(destroyMs, BenchUtils::bestOf(1, [&] { map.reset(); }));
+            }
+            std::cout << "  " << std::left << std::setw(12) << name << std::right << std::setprecision(2) << "load "
+                << loadMs << " ms, reload " << reloadMs << " ms, destroy " << destroyMs << " ms\n";
+        }
+    }
+
+    // Wiele przebiegów na jednym planie: każdy sprząta kwadrat wokół losowego miejsca
+    void benchSharedBase(const std::string& text, size_t width, size_t height, size_t runs) {
+        std::cout << "\nShared base, " << runs << " runs of " << width << "x" << height << ":\n";
+        std::istringstream in(text);
+        std::shared_ptr<const Map> base = Map::share(Map(in));
+        double copyMs = BenchUtils::bestOf(1, [&] { Map copy(*base); });
+
+        const size_t side = 48;
+        std::mt19937 gen(7);
+        std::vector<Map> overlays;
+        overlays.reserve(runs);
+        size_t cleaned = 0;
+        double runsMs = BenchUtils::bestOf(1, [&] {
+            for (size_t run = 0; run < runs; ++run) {
+                Map& overlay = overlays.emplace_back(base);
+                const size_t x0 = gen() % (width - side), y0 = gen() % (height - side);
+                for (size_t y = y0; y < y0 + side; ++y) {
+                    for (size_t x = x0; x < x0 + side; ++x) {
+                        const Floor* floor = overlay.getTile(y * width + x)->asFloor();
+                        if (floor && floor->getCleanliness() > 0) {
+                            overlay.editFloor(y * width + x)->setCleanliness(0);
+                            cleaned++;
+                        }
+                    }
+                }
+            }
+        });
+        size_t copied = 0;
+        for (const Map& overlay : overlays) {
+            copied += overlay.getLoadedChunkCount();
+        }
+        const double chunkMiB = Map::CHUNK_SIDE * Map::CHUNK_SIDE * (sizeof(Tile*) + sizeof(Floor)) / (1024.0 * 1024.0);
+        std::cout << "  full copy " << std::setprecision(2) << copyMs << " ms and ~" << std::setprecision(0)
+            << base->getChunkCount() * chunkMiB << " MiB each, " << copyMs * runs << " ms for all runs\n";
+        std::cout << "  overlays " << std::setprecision(2) << runsMs << " ms for all runs (" << cleaned << " tiles cleaned), "
+            << copied << " chunks copied of " << base->getChunkCount() * runs << ", ~" << std::setprecision(0)
+            << copied * chunkMiB << " MiB besides the base\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 4096;
+    size_t height = 1024;
+    if (argc == 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+
+    std::string text = BenchUtils::generateOfficeMap(width, height);
+    std::cout << "Generated office map: " << width << "x" << height << " (" << text.size() / 1024 << " KiB)\n";
+    MapCodec::Kernel bestKernel = MapCodec::activeKernel();
+    std::cout << "Best kernel on this CPU: " << MapCodec::kernelName(bestKernel) << "\n";
+
+    benchCodec(text, width, height);
+    benchMapIo(text, width, height);
+
+    MapCodec::setKernel(bestKernel);
+    benchRle("furnished office", text, width, height);
+    benchRle("sparse office", BenchUtils::generateOfficeMap(width, height, 1, 2, 2), width, height);
+    benchRobotMemory(8192, 256);
+    benchSharedBase(text, width, height, 1000);
+    benchTileAllocation(4096);
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "BenchUtils.h"
+#include "Map.h"
+#include "Robot.h"
+
+namespace {
+    void printRow(const std::string& name, double ms) {
+        std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << ms << " ms\n";
+    }
+
+    // Builds a robot save whose memory already contains the whole map
+    std::string explorerSave(const std::string& mapText, size_t size, size_t chargerId) {
+        std::string save = mapText + "\n";
+        save += std::to_string(chargerId) + " " + std::to_string(chargerId) + " 1 0 " + std::to_string(size) + " ";
+        save.reserve(save.size() + 2 * size + 4);
+        for (size_t i = 0; i < size; ++i) {
+            save += "0 ";
+        }
+        save += "0\n";
+        return save;
+    }
+
+    // Kilka kroków robota razem ze światem: odczyt czujników, krok, sprzątanie świata
+    void runBranch(Robot& robot, Map& world, size_t steps) {
+        for (size_t i = 0; i < steps; ++i) {
+            const size_t position = robot.getPosition();
+            robot.exploreTile(position, world.getTile(position));
+            const RobotStep step = robot.step();
+            if (step.error != RobotError::none || step.action == RobotAction::none) {
+                return;
+            }
+            if (step.action == RobotAction::clean) {
+                world.editFloor(position)->getCleaned(robot.getCleaningEfficiency());
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 2048;
+    size_t height = 2048;
+    if (argc == 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+
+    std::string text = BenchUtils::generateOfficeMap(width, height);
+    std::istringstream mapStream(text);
+    Map map(mapStream);
+    std::cout << "Generated office map: " << width << "x" << height << "\n\n";
+
+    double validateMs = BenchUtils::bestOf(5, [&]() {
+        volatile bool valid = map.isMapValid();
+        (void)valid;
+    });
+    printRow("Map::isMapValid", validateMs);
+
+    // Walkable tile in the last complete room - partial rooms at the edges have no doors
+    const size_t roomSize = 24;
+    const size_t lastRoomX = (width - 1) / roomSize * roomSize - roomSize / 2;
+    const size_t lastRoomY = (height - 1) / roomSize * roomSize - roomSize / 2;
+    size_t target = lastRoomY * width + lastRoomX;
+    while (target > 0 && !map.canMoveOn(target)) {
+        target--;
+    }
+
+    std::istringstream robotStream(explorerSave(text, map.getSize(), map.getChargerId()));
+    Robot robot(robotStream);
+
+    bool reachable = true;
+    double pathMs = BenchUtils::bestOf(5, [&]() {
+        reachable = robot.orderToMove(target);
+    });
+    printRow("Robot::orderToMove (BFS across map)", pathMs);
+    std::cout << "  target " << target << (reachable ? "" : " unreachable") << ", path: " << robot.getPath().size() << " steps, " << robot.getPath().memoryBytes()
+        << " bytes (" << robot.getPath().size() * sizeof(size_t) << " as tile ids)\n";
+
+    // Tile inside a closed room at the map edge - no door leads there
+    size_t closedTile = map.getSize() - width - 2;
+    double unreachableMs = BenchUtils::bestOf(5, [&]() {
+        robot.orderToMove(closedTile);
+    });
+    printRow("Robot::orderToMove (unreachable)", unreachableMs);
+
+    // 500x500 area around the charger: radius order walks a diamond, region order only the rectangle rows
+    const size_t chargerX = map.getChargerId() % width;
+    const size_t chargerY = map.getChargerId() / width;
+    double radiusMs = BenchUtils::bestOf(5, [&]() {
+        robot.orderToClean(map.getChargerId(), 250);
+    });
+    printRow("Robot::orderToClean (radius 250)", radiusMs);
+    std::cout << "  tiles to check: " << robot.getTilesToCheckCount() << "\n";
+    {
+        // Kroki po takim zleceniu: każdy kolejny cel to najbliższy kafelek do sprawdzenia
+        Robot stepper = robot;
+        Map world = map;
+        const size_t steps = 2000;
+        double stepsMs = BenchUtils::bestOf(1, [&]() { runBranch(stepper, world, steps); });
+        printRow("Robot::step after orderToClean", stepsMs / steps);
+        std::cout << "  per step, " << stepper.getTilesToCheckCount() << " tiles left to check\n";
+    }
+
+    Region zone = Region::rect(static_cast<int64_t>(chargerX) - 250, static_cast<int64_t>(chargerY) - 250,
+        static_cast<int64_t>(chargerX) + 249, static_cast<int64_t>(chargerY) + 249);
+    double regionMs = BenchUtils::bestOf(5, [&]() {
+        robot.orderToCleanRegion(zone);
+    });
+    printRow("Robot::orderToCleanRegion (500x500)", regionMs);
+    std::cout << "  tiles to check: " << robot.getTilesToCheckCount() << "\n";
+
+    double cleanMs = BenchUtils::bestOf(5, [&]() {
+        robot.orderToCleanEfficiently();
+    });
+    printRow("Robot::orderToCleanEfficiently", cleanMs);
+
+    double robotValidMs = BenchUtils::bestOf(5, [&]() {
+        volatile bool valid = robot.isRobotStateValid();
+        (void)valid;
+    });
+    printRow("Robot::isRobotStateValid", robotValidMs);
+
+    // Sensor updates of tiles the robot already knows - the steady state of a simulation
+    double exploreMs = BenchUtils::bestOf(5, [&]() {
+        for (size_t i = 0; i < map.getSize(); ++i) {
+            robot.exploreTile(i, map.getTile(i));
+        }
+    });
+    printRow("Robot::exploreTile (known tiles)", exploreMs);
+
+    // Planowanie z wyprzedzeniem: każda gałąź zaczyna od tego samego stanu robota i świata
+    const size_t branchSteps = 32;
+    robot.setPosition(map.getChargerId());
+    robot.orderToClean(map.getChargerId(), 30);
+    double copyMs = BenchUtils::bestOf(1, [&]() {
+        for (int i = 0; i < 2; ++i) {
+            Robot branchRobot = robot;
+            Map branchWorld = map;
+            runBranch(branchRobot, branchWorld, branchSteps);
+        }
+    }) / 2;
+    const size_t branches = 200;
+    double restoreMs = 0;
+    double branchMs = BenchUtils::bestOf(1, [&]() {
+        const RobotSnapshot robotSnapshot = robot.snapshot();
+        const size_t worldSnapshot = map.snapshot();
+        for (size_t i = 0; i < branches; ++i) {
+            runBranch(robot, map, branchSteps);
+            restoreMs += BenchUtils::bestOf(1, [&]() {
+                robot.rollback(robotSnapshot);
+                map.rollback(worldSnapshot);
+            });
+        }
+        robot.commit();
+        map.commit();
+    }) / branches;
+    restoreMs /= branches;
+    std::cout << "\nLookahead branch of " << branchSteps << " steps:\n";
+    printRow("copy robot and world", copyMs);
+    printRow("snapshot, steps and rollback", branchMs);
+    printRow("  of which rollback", restoreMs);
+    std::cout << "  " << std::setprecision(0) << 1000.0 / branchMs << " branches/s with rollback, "
+        << 1000.0 / copyMs << " with copies; state restored " << 1000.0 / restoreMs << " times/s\n";
+    return 0;
+}
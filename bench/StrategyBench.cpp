@@ -0,0 +1,151 @@
+#include <future>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchUtils.h"
+#include "Robot.h"
+#include "CleaningStrategy.h"
+
+namespace {
+    // What the robot knows at the start: the whole map with a planned tour, the whole map, nothing
+    enum class Memory { tour, known, unknown };
+
+    struct RunStats {
+        std::string strategy;
+        Memory memory = Memory::unknown;
+        unsigned seed = 0;
+        size_t steps = 0;
+        size_t distance = 0;
+        unsigned int dirtLeft = 0;
+        size_t halfCleanSteps = 0;      // Steps until half of the dirt was cleaned
+        double planningMs = 0;
+    };
+
+    unsigned int totalDirt(const Map& map) {
+        unsigned int dirt = 0;
+        for (size_t i = 0; i < map.getSize(); ++i) {
+            if (const Floor* floor = map.getTile(i)->asFloor()) {
+                dirt += floor->getCleanliness();
+            }
+        }
+        return dirt;
+    }
+
+    Robot makeRobot(const std::string& mapText, const Map& world, Memory memory) {
+        if (memory == Memory::unknown) {
+            return Robot(world.getWidth(), world.getHeight(), world.getChargerId());
+        }
+        std::string save = mapText + "\n" + std::to_string(world.getChargerId()) + " "
+            + std::to_string(world.getChargerId()) + " 1 0 " + std::to_string(world.getSize());
+        for (size_t i = 0; i < world.getSize(); ++i) {
+            save += " 0";
+        }
+        save += " 0\n";
+        std::istringstream in(save);
+        return Robot(in);
+    }
+
+    // Same loop as Simulation::runSimulation without console output
+    RunStats runStrategy(const std::string& strategy, size_t width, size_t height, unsigned seed,
+        Memory memory, size_t maxSteps) {
+        std::string mapText = BenchUtils::generateOfficeMap(width, height, seed);
+        std::istringstream mapStream(mapText);
+        Map world(mapStream);
+        Robot robot = makeRobot(mapText, world, memory);
+        robot.setCleaningStrategy(makeCleaningStrategy(strategy));
+        if (memory == Memory::tour) {
+            robot.orderToCleanEfficiently();
+        }
+
+        RunStats stats{ strategy, memory, seed };
+        const unsigned int startDirt = totalDirt(world);
+        unsigned int cleaned = 0;
+        for (; stats.steps < maxSteps; ++stats.steps) {
+            size_t position = robot.getPosition();
+            robot.exploreTile(position, world.getTile(position));
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                if (auto neighbour = world.getIndex(position, dir)) {
+                    robot.exploreTile(*neighbour, world.getTile(*neighbour));
+                }
+            }
+
+            double start = BenchUtils::threadCpuMs();
+            RobotStep step = robot.step();
+            stats.planningMs += BenchUtils::threadCpuMs() - start;
+
+            if (step.action == RobotAction::none || step.error != RobotError::none) {
+                break;
+            }
+            if (step.action == RobotAction::move) {
+                stats.distance++;
+            }
+            else if (step.action == RobotAction::clean) {
+                Floor* floor = world.editFloor(robot.getPosition());
+                const unsigned int before = floor->getCleanliness();
+                floor->getCleaned(robot.getCleaningEfficiency());
+                cleaned += before - floor->getCleanliness();
+                if (stats.halfCleanSteps == 0 && 2 * cleaned >= startDirt) {
+                    stats.halfCleanSteps = stats.steps + 1;
+                }
+            }
+        }
+        stats.dirtLeft = totalDirt(world);
+        return stats;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t width = 64;
+    size_t height = 64;
+    unsigned seeds = 4;
+    if (argc >= 3) {
+        width = std::stoul(argv[1]);
+        height = std::stoul(argv[2]);
+    }
+    if (argc >= 4) {
+        seeds = static_cast<unsigned>(std::stoul(argv[3]));
+    }
+    const size_t maxSteps = width * height * 4;
+
+    // Every (strategy, map, seed) run is independent, so they all go to separate threads
+    std::vector<std::future<RunStats>> runs;
+    for (Memory memory : { Memory::tour, Memory::known, Memory::unknown }) {
+        for (const std::string& strategy : cleaningStrategyNames()) {
+            for (unsigned seed = 1; seed <= seeds; ++seed) {
+                runs.push_back(std::async(std::launch::async, runStrategy, strategy, width, height, seed,
+                    memory, maxSteps));
+            }
+        }
+    }
+
+    std::cout << "Office map " << width << "x" << height << ", " << seeds << " seeds, up to " << maxSteps << " steps\n\n";
+    std::cout << std::left << std::setw(10) << "memory" << std::setw(20) << "strategy" << std::right
+        << std::setw(10) << "steps" << std::setw(10) << "distance" << std::setw(11) << "dirt left"
+        << std::setw(12) << "half clean"
+        << std::setw(15) << "planning ms" << "\n";
+
+    // Averages over seeds; runs are grouped by (memory, strategy) in launch order
+    for (size_t group = 0; group < runs.size(); group += seeds) {
+        RunStats total;
+        for (size_t i = group; i < group + seeds; ++i) {
+            RunStats stats = runs[i].get();
+            total.strategy = stats.strategy;
+            total.memory = stats.memory;
+            total.steps += stats.steps;
+            total.distance += stats.distance;
+            total.dirtLeft += stats.dirtLeft;
+            total.halfCleanSteps += stats.halfCleanSteps;
+            total.planningMs += stats.planningMs;
+        }
+        std::cout << std::left << std::setw(10) << (total.memory == Memory::tour ? "tour" : total.memory == Memory::known ? "known" : "unknown")
+            << std::setw(20) << total.strategy << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << static_cast<double>(total.steps) / seeds
+            << std::setw(10) << static_cast<double>(total.distance) / seeds
+            << std::setw(11) << static_cast<double>(total.dirtLeft) / seeds
+            << std::setw(12) << static_cast<double>(total.halfCleanSteps) / seeds
+            << std::setw(15) << total.planningMs / seeds << "\n";
+    }
+    return 0;
+}
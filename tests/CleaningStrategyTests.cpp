@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include "../Robot/Robot.h"
+#include "../Robot/CleaningStrategy.h"
+#include "../Robot/MctsStrategy.h"
+#include "TestMaps.h"
+
+using namespace TestMaps;
+
+namespace {
+    const char* WORLD =
+        "PPPPPPPPPP\n"
+        "P0030P0090\n"
+        "P0B00P0000\n"
+        "P0000P0PP0\n"
+        "P5000000P0\n"
+        "PPP0PPP0P0\n"
+        "P0000200P0\n"
+        "P00P00000P\n";
+
+    struct RunResult {
+        size_t steps = 0;
+        size_t moves = 0;
+        bool finished = false;
+    };
+
+    // Senses, acts and cleans the world until the robot reports nothing left to do
+    RunResult run(Map& world, Robot& robot, size_t maxSteps) {
+        RunResult result;
+        for (; result.steps < maxSteps; ++result.steps) {
+            size_t position = robot.getPosition();
+            robot.exploreTile(position, world.getTile(position));
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                if (auto neighbour = world.getIndex(position, dir)) {
+                    robot.exploreTile(*neighbour, world.getTile(*neighbour));
+                }
+            }
+
+            RobotStep step = robot.step();
+            EXPECT_EQ(step.error, RobotError::none);
+            if (step.action == RobotAction::none || step.error != RobotError::none) {
+                result.finished = step.error == RobotError::none;
+                break;
+            }
+            if (step.action == RobotAction::move) {
+                result.moves++;
+            }
+            if (step.action == RobotAction::clean) {
+                world.editFloor(robot.getPosition())->getCleaned(robot.getCleaningEfficiency());
+            }
+        }
+        return result;
+    }
+
+    std::string knownWorldSave() {
+        std::string save = std::string(WORLD) + "\n22 22 1 0 80";
+        for (int i = 0; i < 80; ++i) {
+            save += " 0";
+        }
+        return save + " 0\n";
+    }
+}
+
+class CleaningStrategyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::istringstream iss(WORLD);
+        world.loadMap(iss);
+    }
+
+    Map world;
+};
+
+TEST_F(CleaningStrategyTest, FactoryKnowsAllNames) {
+    for (const std::string& name : cleaningStrategyNames()) {
+        auto strategy = makeCleaningStrategy(name);
+        ASSERT_NE(strategy, nullptr) << name;
+        EXPECT_EQ(strategy->getName(), name);
+    }
+    EXPECT_EQ(makeCleaningStrategy("unknown"), nullptr);
+}
+
+TEST_F(CleaningStrategyTest, DefaultIsGreedy) {
+    Robot robot(3, 3, 4);
+    EXPECT_STREQ(robot.getCleaningStrategy().getName(), "greedy");
+
+    robot.setCleaningStrategy(makeCleaningStrategy("frontier-first"));
+    EXPECT_STREQ(robot.getCleaningStrategy().getName(), "frontier-first");
+    robot.setCleaningStrategy(nullptr);
+    EXPECT_STREQ(robot.getCleaningStrategy().getName(), "greedy");
+}
+
+TEST_F(CleaningStrategyTest, EveryStrategyCleansKnownWorld) {
+    ASSERT_GT(totalDirt(world), 0u);
+    for (const std::string& name : cleaningStrategyNames()) {
+        Map dirtyWorld(world);
+        std::istringstream iss(knownWorldSave());
+        Robot robot(iss);
+        robot.setCleaningStrategy(makeCleaningStrategy(name));
+        robot.orderToCleanEfficiently();
+
+        RunResult result = run(dirtyWorld, robot, 1000);
+        EXPECT_TRUE(result.finished) << name;
+        EXPECT_EQ(totalDirt(dirtyWorld), 0u) << name;
+        EXPECT_EQ(robot.getPosition(), world.getChargerId()) << name;
+    }
+}
+
+TEST_F(CleaningStrategyTest, FrontierFirstExploresUnknownWorld) {
+    Robot greedy(world.getWidth(), world.getHeight(), world.getChargerId());
+    Map greedyWorld(world);
+    run(greedyWorld, greedy, 1000);
+    EXPECT_GT(totalDirt(greedyWorld), 0u);
+
+    Robot frontier(world.getWidth(), world.getHeight(), world.getChargerId());
+    frontier.setCleaningStrategy(makeCleaningStrategy("frontier-first"));
+    RunResult result = run(world, frontier, 1000);
+    EXPECT_TRUE(result.finished);
+    EXPECT_EQ(totalDirt(world), 0u);
+
+    // Every tile reachable from the charger has been seen
+    for (size_t i = 0; i < world.getSize(); ++i) {
+        if (world.canMoveOn(i)) {
+            EXPECT_NE(frontier.getMemoryMap().getTile(i)->getKind(), TileKind::unvisited) << i;
+        }
+    }
+}
+
+TEST_F(CleaningStrategyTest, DirtPerDistancePrefersHeavierTrash) {
+    // Dirt 1 right next to the charger, dirt 9 two tiles away on the other side
+    std::string save = "PPPPPPP\nP1B09PP\nPPPPPPP\n\n9 9 1 0 21";
+    for (int i = 0; i < 21; ++i) {
+        save += " 0";
+    }
+    save += " 0\n";
+
+    std::istringstream greedySave(save);
+    Robot greedy(greedySave);
+    greedy.step();
+    EXPECT_EQ(greedy.getPosition(), 8u);
+
+    std::istringstream ratioSave(save);
+    Robot ratio(ratioSave);
+    ratio.setCleaningStrategy(makeCleaningStrategy("dirt-per-distance"));
+    ratio.step();
+    EXPECT_EQ(ratio.getPosition(), 10u);
+}
+
+TEST_F(CleaningStrategyTest, MctsLooksPastNearestTrash) {
+    // W horyzoncie 4 kroków opłaca się tylko ciężki brud, bliski kafelek zabrałby dwa kroki na nic
+    std::string save = "PPPPPPP\nP1B09PP\nPPPPPPP\n\n9 9 1 0 21";
+    for (int i = 0; i < 21; ++i) {
+        save += " 0";
+    }
+    save += " 0\n";
+
+    MctsStrategy::Options options;
+    options.budgetMs = 10000;
+    options.horizon = 4;
+    options.maxIterations = 200;
+    for (unsigned threads : { 1u, 4u }) {
+        options.threads = threads;
+        std::istringstream robotSave(save);
+        Robot robot(robotSave);
+        robot.setCleaningStrategy(std::make_shared<MctsStrategy>(options));
+        robot.step();
+        EXPECT_EQ(robot.getPosition(), 10u) << threads;
+    }
+
+    options.candidates = 1000;
+    EXPECT_EQ(MctsStrategy(options).getOptions().candidates, MctsStrategy::MAX_CANDIDATES);
+}
+
+TEST_F(CleaningStrategyTest, MctsDecisionKeepsBudgetOnLargeMap) {
+    // Budżet liczy się od wejścia do decyzji; przygotowanie nie może zależeć od rozmiaru mapy
+    Map world = makeMap(randomMapText(5, 1024, 1024, true));
+    Robot robot = knownRobot(world);
+    const size_t start = robot.getPosition();
+    for (double budgetMs : { 2.0, 0.001 }) {
+        MctsStrategy::Options options;
+        options.budgetMs = budgetMs;
+        options.threads = 1;
+        MctsStrategy strategy(options);
+        // Pierwsza decyzja przygotowuje bufory wątku
+        ASSERT_EQ(strategy.plan(robot), RobotAction::clean);
+
+        double slowestMs = 0;
+        for (int decision = 0; decision < 5; ++decision) {
+            robot.setPosition(start);
+            const auto begin = std::chrono::steady_clock::now();
+            ASSERT_EQ(strategy.plan(robot), RobotAction::clean);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+            slowestMs = std::max(slowestMs, elapsed.count());
+        }
+        EXPECT_LT(slowestMs, budgetMs + 10.0) << budgetMs;
+    }
+}
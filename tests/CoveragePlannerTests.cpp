@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../Robot/Map.h"
+#include "../Robot/CoveragePlanner.h"
+#include "TestMaps.h"
+
+using namespace TestMaps;
+
+namespace {
+    // Every route tile is walkable and next to the previous one, and every reachable tile is visited
+    void expectFullCoverage(const Map& map, size_t start, const std::vector<size_t>& route,
+        size_t reachableTiles) {
+        std::vector<bool> visited(map.getSize(), false);
+        visited[start] = true;
+        size_t previous = start;
+        for (size_t tile : route) {
+            ASSERT_TRUE(map.canMoveOn(tile)) << tile;
+            bool adjacent = false;
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                adjacent = adjacent || map.getIndex(previous, dir) == tile;
+            }
+            ASSERT_TRUE(adjacent) << previous << " -> " << tile;
+            visited[tile] = true;
+            previous = tile;
+        }
+        size_t visitedCount = 0;
+        for (bool v : visited) {
+            visitedCount += v;
+        }
+        EXPECT_EQ(visitedCount, reachableTiles);
+    }
+}
+
+TEST(CoveragePlannerTest, OpenRoomIsOneCell) {
+    Map map = makeMap("0000\n0B00\n0000\n");
+    CoveragePlanner planner(map);
+    std::vector<size_t> route = planner.plan(map.getChargerId());
+
+    EXPECT_EQ(planner.getCells().size(), 1u);
+    EXPECT_EQ(planner.getSearchCount(), 1u);
+    expectFullCoverage(map, map.getChargerId(), route, 12);
+    // A sweep of 12 tiles needs at most one extra step to reach a corner and a few to turn into columns
+    EXPECT_LE(route.size(), 16u);
+}
+
+TEST(CoveragePlannerTest, ObstacleSplitsCells) {
+    Map map = makeMap(
+        "00000\n"
+        "0BP00\n"
+        "00P00\n"
+        "00000\n");
+    CoveragePlanner planner(map);
+    std::vector<size_t> route = planner.plan(map.getChargerId());
+
+    // Left part, the two columns split by the obstacle, then the right part
+    EXPECT_EQ(planner.getCells().size(), 4u);
+    expectFullCoverage(map, map.getChargerId(), route, 18);
+}
+
+TEST(CoveragePlannerTest, UnreachableTilesAreSkipped) {
+    Map map = makeMap(
+        "0P00\n"
+        "BP00\n"
+        "0P00\n");
+    CoveragePlanner planner(map);
+    std::vector<size_t> route = planner.plan(map.getChargerId());
+
+    EXPECT_EQ(planner.getCells().size(), 1u);
+    expectFullCoverage(map, map.getChargerId(), route, 3);
+}
+
+TEST(CoveragePlannerTest, RandomMapsAreFullyCovered) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int round = 0; round < 20; ++round) {
+        const size_t width = 12 + round;
+        const size_t height = 9 + round % 5;
+        std::string text;
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                text += (x == 0 && y == 0) ? 'B' : (percent(gen) < 25 ? 'P' : '0');
+            }
+            text += '\n';
+        }
+        Map map = makeMap(text);
+
+        // Reachable count by flood fill
+        std::vector<bool> seen(map.getSize(), false);
+        std::vector<size_t> stack{ 0 };
+        seen[0] = true;
+        size_t reachable = 0;
+        while (!stack.empty()) {
+            size_t tile = stack.back();
+            stack.pop_back();
+            reachable++;
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                auto neighbour = map.getIndex(tile, dir);
+                if (neighbour && !seen[*neighbour] && map.canMoveOn(*neighbour)) {
+                    seen[*neighbour] = true;
+                    stack.push_back(*neighbour);
+                }
+            }
+        }
+
+        CoveragePlanner planner(map);
+        std::vector<size_t> route = planner.plan(0);
+        expectFullCoverage(map, 0, route, reachable);
+        EXPECT_LE(planner.getSearchCount(), planner.getCells().size());
+    }
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include "../Robot/Map.h"
+#include "../Robot/Robot.h"
+#include "TestMaps.h"
+
+using namespace TestMaps;
+
+TEST(DistanceMatrixTest, StepsAroundObstacles) {
+    Map map = makeMap(
+        "B0P00\n"
+        "00P00\n"
+        "00000\n");
+    DistanceMatrix matrix = map.distances({ 0 }, { 0, 1, 4, 14, 2 });
+    ASSERT_EQ(matrix.sourceCount(), 1u);
+    ASSERT_EQ(matrix.targetCount(), 5u);
+    EXPECT_EQ(matrix.at(0, 0), 0u);
+    EXPECT_EQ(matrix.at(0, 1), 1u);
+    EXPECT_EQ(matrix.at(0, 2), 8u);   // Down and around the wall
+    EXPECT_EQ(matrix.at(0, 3), 6u);
+    EXPECT_EQ(matrix.at(0, 4), DistanceMatrix::UNREACHABLE);   // Obstacle
+    EXPECT_EQ(matrix.nearestTarget(0), 0u);
+}
+
+TEST(DistanceMatrixTest, SeparateComponentsAreUnreachable) {
+    Map map = makeMap(
+        "B0P00\n"
+        "00P00\n");
+    DistanceMatrix matrix = map.distances({ 0, 4 }, { 1, 3, 9 });
+    EXPECT_EQ(matrix.at(0, 0), 1u);
+    EXPECT_EQ(matrix.at(0, 1), DistanceMatrix::UNREACHABLE);
+    EXPECT_EQ(matrix.at(0, 2), DistanceMatrix::UNREACHABLE);
+    EXPECT_EQ(matrix.at(1, 0), DistanceMatrix::UNREACHABLE);
+    EXPECT_EQ(matrix.at(1, 1), 1u);
+    EXPECT_EQ(matrix.at(1, 2), 1u);
+    EXPECT_EQ(matrix.nearestTarget(1), 1u);
+}
+
+TEST(DistanceMatrixTest, DuplicateTargetsAndEmptyInput) {
+    Map map = makeMap(
+        "B000\n");
+    DistanceMatrix matrix = map.distances({ 3, 0 }, { 1, 1, 3 });
+    EXPECT_EQ(matrix.at(0, 0), 2u);
+    EXPECT_EQ(matrix.at(0, 1), 2u);
+    EXPECT_EQ(matrix.at(0, 2), 0u);
+    EXPECT_EQ(matrix.at(1, 0), 1u);
+    EXPECT_EQ(matrix.at(1, 1), 1u);
+
+    DistanceMatrix noTargets = map.distances({ 0 }, {});
+    EXPECT_EQ(noTargets.targetCount(), 0u);
+    EXPECT_EQ(noTargets.nearestTarget(0), DistanceMatrix::npos);
+    EXPECT_EQ(map.distances({}, { 1 }).sourceCount(), 0u);
+}
+
+TEST(DistanceMatrixTest, InvalidTileThrows) {
+    Map map = makeMap(
+        "B00\n");
+    EXPECT_THROW(map.distances({ 3 }, { 0 }), std::out_of_range);
+    EXPECT_THROW(map.distances({ 0 }, { 7 }), std::out_of_range);
+}
+
+TEST(DistanceMatrixTest, StopsWhenAllTargetsAreFound) {
+    std::string text;
+    for (int y = 0; y < 200; ++y) {
+        text += std::string(200, '0') + '\n';
+    }
+    text[0] = 'B';
+    Map map = makeMap(text.c_str());
+    DistanceMatrix matrix = map.distances({ 0 }, { 1, 200 });
+    EXPECT_EQ(matrix.at(0, 0), 1u);
+    EXPECT_EQ(matrix.at(0, 1), 1u);
+    EXPECT_LT(matrix.getVisitedTiles(), 10u);
+}
+
+TEST(DistanceMatrixTest, ThreadsGiveSameResult) {
+    std::mt19937 rng(7);
+    std::ostringstream text;
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 60; ++x) {
+            text << (x == 0 && y == 0 ? 'B' : rng() % 4 == 0 ? 'P' : '0');
+        }
+        text << '\n';
+    }
+    Map map = makeMap(text.str().c_str());
+    std::vector<size_t> sources{ map.getChargerId() }, targets;
+    for (size_t i = 0; i < 30; ++i) {
+        sources.push_back(rng() % map.getSize());
+    }
+    for (size_t i = 0; i < 200; ++i) {
+        targets.push_back(rng() % map.getSize());
+    }
+
+    DistanceMatrix single = map.distances(sources, targets);
+    DistanceMatrix threaded = map.distances(sources, targets, 4);
+    for (size_t s = 0; s < sources.size(); ++s) {
+        for (size_t t = 0; t < targets.size(); ++t) {
+            ASSERT_EQ(single.at(s, t), threaded.at(s, t));
+        }
+    }
+
+    // Długość trasy planowanej przez robota jest taka sama
+    Robot robot(map.getWidth(), map.getHeight(), map.getChargerId());
+    for (size_t id = 0; id < map.getSize(); ++id) {
+        robot.exploreTile(id, map.getTile(id));
+    }
+    for (size_t t = 0; t < targets.size(); ++t) {
+        if (!map.canMoveOn(targets[t]) || sources[0] == targets[t]) {
+            continue;
+        }
+        robot.setPosition(sources[0]);
+        const bool reachable = single.at(0, t) != DistanceMatrix::UNREACHABLE;
+        ASSERT_EQ(robot.orderToMove(targets[t]), reachable);
+        if (reachable) {
+            EXPECT_EQ(robot.getPath().size(), single.at(0, t));
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include "../Robot/Fleet.h"
+#include "TestMaps.h"
+
+using namespace TestMaps;
+
+namespace {
+    // No two robots on one tile except the charger
+    bool tilesAreExclusive(const Fleet& fleet, size_t chargerId) {
+        std::set<size_t> taken;
+        for (size_t i = 0; i < fleet.size(); ++i) {
+            size_t position = fleet.getPosition(i);
+            if (position != chargerId && !taken.insert(position).second) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(FleetTest, AddRobotValidatesPosition) {
+    Map world = makeMap(
+        "B0P\n"
+        "000\n");
+    Fleet fleet(world);
+    EXPECT_EQ(fleet.addRobot(0), 0u);
+    EXPECT_EQ(fleet.addRobot(0), 1u);   // Charger holds any number of robots
+    EXPECT_EQ(fleet.addRobot(4), 2u);
+    EXPECT_THROW(fleet.addRobot(4), std::runtime_error);
+    EXPECT_THROW(fleet.addRobot(2), std::runtime_error);
+    EXPECT_THROW(fleet.addRobot(Robot(4, 2, 0)), std::runtime_error);
+    EXPECT_EQ(fleet.size(), 3u);
+    EXPECT_EQ(fleet.getMetrics().size(), 3u);
+}
+
+TEST(FleetTest, RobotsCleanWorldTogether) {
+    Map world = makeMap(
+        "30000P0002\n"
+        "0B000P0000\n"
+        "0000000050\n"
+        "40000P0000\n");
+    Fleet fleet(world);
+    for (int i = 0; i < 3; ++i) {
+        fleet.addRobot(knownRobot(world, world.getChargerId()));
+    }
+
+    for (size_t tick = 0; tick < 500 && fleet.getActiveCount() > 0; ++tick) {
+        fleet.tick();
+        ASSERT_TRUE(tilesAreExclusive(fleet, world.getChargerId()));
+    }
+    EXPECT_EQ(fleet.getActiveCount(), 0u);
+    EXPECT_EQ(totalDirt(world), 0u);
+
+    const FleetMetrics& metrics = fleet.getMetrics();
+    EXPECT_EQ(std::accumulate(metrics.dirtCleaned.begin(), metrics.dirtCleaned.end(), uint64_t{ 0 }), 14u);
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        EXPECT_EQ(fleet.getError(i), RobotError::none);
+        EXPECT_GT(metrics.moves[i], 0u);
+        EXPECT_EQ(fleet.getPosition(i), world.getChargerId());
+    }
+}
+
+TEST(FleetTest, RobotsPassInCorridor) {
+    // One-tile corridor: the robots have to swap ends
+    Map world = makeMap(
+        "PPPPPPPPP\n"
+        "B0000000P\n"
+        "P0PPPPP0P\n");
+    Fleet fleet(world);
+    size_t left = fleet.addRobot(knownRobot(world, 1 * 9 + 2));
+    size_t right = fleet.addRobot(knownRobot(world, 1 * 9 + 6));
+    ASSERT_TRUE(fleet.getRobot(left).orderToMove(1 * 9 + 7));
+    ASSERT_TRUE(fleet.getRobot(right).orderToMove(1 * 9 + 1));
+
+    bool leftArrived = false;
+    bool rightArrived = false;
+    for (size_t tick = 0; tick < 100 && !(leftArrived && rightArrived); ++tick) {
+        fleet.tick();
+        ASSERT_TRUE(tilesAreExclusive(fleet, world.getChargerId()));
+        leftArrived = leftArrived || fleet.getPosition(left) == 1 * 9 + 7;
+        rightArrived = rightArrived || fleet.getPosition(right) == 1 * 9 + 1;
+    }
+    EXPECT_TRUE(leftArrived);
+    EXPECT_TRUE(rightArrived);
+    EXPECT_GT(fleet.getMetrics().waits[right] + fleet.getMetrics().waits[left], 0u);
+    EXPECT_GT(fleet.getMetrics().sidesteps[right], 0u);
+}
+
+TEST(FleetTest, SharedDiscoveryUpdatesAllMemories) {
+    Map world = makeMap(
+        "B0000\n"
+        "00000\n"
+        "00000\n");
+    Fleet::Options options;
+    options.shareDiscovery = true;
+    Fleet shared(world, options);
+    shared.addRobot(world.getChargerId());
+    shared.addRobot(14);
+    shared.tick();
+    // Second robot knows the charger's neighbour sensed by the first one
+    EXPECT_FALSE(shared.getRobot(1).getMemoryMap().getTile(1)->getKind() == TileKind::unvisited);
+
+    Map otherWorld = world;
+    Fleet separate(otherWorld);
+    separate.addRobot(otherWorld.getChargerId());
+    separate.addRobot(14);
+    separate.tick();
+    EXPECT_TRUE(separate.getRobot(1).getMemoryMap().getTile(1)->getKind() == TileKind::unvisited);
+}
+
+TEST(FleetTest, RobotsClaimDifferentDirt) {
+    Map world = makeMap(
+        "B0005\n"
+        "00000\n"
+        "00005\n");
+    Fleet fleet(world);
+    fleet.addRobot(knownRobot(world, world.getChargerId()));
+    fleet.addRobot(knownRobot(world, world.getChargerId()));
+    fleet.tick();
+    fleet.tick();
+    ASSERT_FALSE(fleet.getRobot(0).getPath().empty());
+    ASSERT_FALSE(fleet.getRobot(1).getPath().empty());
+    EXPECT_NE(fleet.getRobot(0).getPath().back(), fleet.getRobot(1).getPath().back());
+
+    fleet.run(100);
+    EXPECT_EQ(totalDirt(world), 0u);
+    EXPECT_GT(fleet.getMetrics().dirtCleaned[0], 0u);
+    EXPECT_GT(fleet.getMetrics().dirtCleaned[1], 0u);
+}
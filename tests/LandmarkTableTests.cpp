@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "../Robot/Robot.h"
+#include "TestMaps.h"
+
+using namespace TestMaps;
+
+TEST(LandmarkTableTest, LowerBoundNeverExceedsDistance) {
+    Map map = makeMap(randomMapText(3, 40, 30));
+    LandmarkTable table = LandmarkTable::build(map, 4);
+    ASSERT_EQ(table.getLandmarks().size(), 4u);
+    EXPECT_TRUE(table.fits(map));
+
+    std::vector<size_t> tiles;
+    for (size_t id = 0; id < map.getSize(); id += 7) {
+        tiles.push_back(id);
+    }
+    DistanceMatrix exact = map.distances(tiles, tiles);
+    for (size_t a = 0; a < tiles.size(); ++a) {
+        for (size_t b = 0; b < tiles.size(); ++b) {
+            if (exact.at(a, b) != DistanceMatrix::UNREACHABLE) {
+                ASSERT_LE(table.lowerBound(tiles[a], tiles[b]), exact.at(a, b));
+            }
+        }
+    }
+}
+
+// 32x32 to zarejestrowany plan piętra - odległości liczone na StaticMap
+TEST(LandmarkTableTest, RegisteredPlanMatchesMapDistances) {
+    Map map = makeMap(randomMapText(5, 32, 32));
+    LandmarkTable table = LandmarkTable::build(map, 3);
+    ASSERT_EQ(table.getLandmarks().size(), 3u);
+
+    std::vector<size_t> tiles(map.getSize());
+    for (size_t id = 0; id < tiles.size(); ++id) {
+        tiles[id] = id;
+    }
+    DistanceMatrix exact = map.distances(table.getLandmarks(), tiles);
+    for (size_t k = 0; k < table.getLandmarks().size(); ++k) {
+        for (size_t tile = 0; tile < map.getSize(); ++tile) {
+            const uint32_t expected = exact.at(k, tile);
+            ASSERT_EQ(table.distance(k, tile), expected == DistanceMatrix::UNREACHABLE ? LandmarkTable::UNKNOWN : expected);
+        }
+    }
+}
+
+TEST(LandmarkTableTest, CorridorBoundIsExact) {
+    Map map = makeMap("B000000000\n");
+    LandmarkTable table = LandmarkTable::build(map, 1);
+    ASSERT_EQ(table.getLandmarks().size(), 1u);
+    EXPECT_EQ(table.getLandmarks()[0], 9u);   // Farthest from the charger
+    EXPECT_EQ(table.lowerBound(2, 7), 5u);
+    EXPECT_EQ(table.lowerBound(7, 2), 5u);
+}
+
+TEST(LandmarkTableTest, FewerLandmarksOnSmallMap) {
+    Map map = makeMap("B0\n");
+    LandmarkTable table = LandmarkTable::build(map, 8);
+    EXPECT_EQ(table.getLandmarks().size(), 2u);
+    EXPECT_EQ(table.distance(0, 0), 1u);
+    EXPECT_EQ(table.distance(1, 0), 0u);
+}
+
+TEST(LandmarkTableTest, SaveAndLoad) {
+    Map map = makeMap(randomMapText(5, 30, 20));
+    LandmarkTable table = LandmarkTable::build(map, 3);
+    std::stringstream stream;
+    table.save(stream);
+
+    LandmarkTable loaded;
+    loaded.load(stream);
+    EXPECT_EQ(loaded.getWidth(), 30u);
+    EXPECT_EQ(loaded.getHeight(), 20u);
+    EXPECT_EQ(loaded.getLandmarks(), table.getLandmarks());
+    for (size_t tile = 0; tile < map.getSize(); ++tile) {
+        ASSERT_EQ(loaded.wasWalkable(tile), map.canMoveOn(tile));
+        for (size_t k = 0; k < 3; ++k) {
+            ASSERT_EQ(loaded.distance(k, tile), table.distance(k, tile));
+        }
+    }
+
+    std::string truncated = stream.str();
+    truncated.resize(truncated.size() - 10);
+    std::istringstream truncatedStream(truncated);
+    EXPECT_THROW(loaded.load(truncatedStream), std::runtime_error);
+    std::istringstream garbage("ALT 2\n");
+    EXPECT_THROW(loaded.load(garbage), std::runtime_error);
+    EXPECT_EQ(loaded.getLandmarks(), table.getLandmarks());   // Failed load keeps the table
+}
+
+TEST(LandmarkTableTest, RobotRoutesMatchBreadthFirstSearch) {
+    Map map = makeMap(randomMapText(11, 50, 40));
+    auto table = std::make_shared<const LandmarkTable>(LandmarkTable::build(map, 4));
+    Robot plain = knownRobot(map);
+    Robot guided = knownRobot(map);
+    ASSERT_TRUE(guided.setLandmarks(table));
+
+    std::mt19937 rng(2);
+    for (int i = 0; i < 200; ++i) {
+        size_t from = rng() % map.getSize();
+        size_t to = rng() % map.getSize();
+        if (!map.canMoveOn(from)) {
+            continue;
+        }
+        plain.setPosition(from);
+        guided.setPosition(from);
+        const bool found = plain.orderToMove(to);
+        ASSERT_EQ(guided.orderToMove(to), found);
+        if (found) {
+            ASSERT_EQ(guided.getPath().size(), plain.getPath().size());
+            if (!guided.getPath().empty()) {
+                EXPECT_EQ(guided.getPath().back(), to);
+            }
+        }
+    }
+}
+
+TEST(LandmarkTableTest, NewPassageDropsTable) {
+    Map world = makeMap(
+        "B0P0\n"
+        "00P0\n"
+        "0000\n");
+    auto table = std::make_shared<const LandmarkTable>(LandmarkTable::build(world, 2));
+    Robot robot = knownRobot(world);
+    ASSERT_TRUE(robot.setLandmarks(table));
+
+    // Kolejna przeszkoda nie psuje ograniczeń
+    Obstacle obstacle;
+    robot.exploreTile(8, &obstacle);
+    EXPECT_NE(robot.getLandmarks(), nullptr);
+
+    // Przejście przez ścianę mogłoby skrócić trasę
+    Floor floor;
+    robot.exploreTile(2, &floor);
+    EXPECT_EQ(robot.getLandmarks(), nullptr);
+    EXPECT_FALSE(robot.setLandmarks(table));
+
+    Map other = makeMap("B0\n");
+    EXPECT_FALSE(LandmarkTable::build(other, 1).fits(world));
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Robot/MapCodec.h"
+
+class MapCodecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        previousKernel = MapCodec::activeKernel();
+    }
+
+    void TearDown() override {
+        MapCodec::setKernel(previousKernel);
+    }
+
+    std::vector<MapCodec::Kernel> supportedKernels() const {
+        std::vector<MapCodec::Kernel> kernels;
+        for (MapCodec::Kernel kernel : { MapCodec::Kernel::scalar, MapCodec::Kernel::sse2, MapCodec::Kernel::avx2 }) {
+            if (MapCodec::isKernelSupported(kernel)) {
+                kernels.push_back(kernel);
+            }
+        }
+        return kernels;
+    }
+
+    MapCodec::Kernel previousKernel = MapCodec::Kernel::scalar;
+};
+
+// Test decoding of every valid character
+TEST_F(MapCodecTest, DecodeValidCharacters) {
+    std::string row = "0123456789PB?";
+    std::vector<uint8_t> codes(row.size());
+
+    for (MapCodec::Kernel kernel : supportedKernels()) {
+        MapCodec::setKernel(kernel);
+        MapCodec::DecodeResult result = MapCodec::decodeRow(row.data(), row.size(), codes.data(), true);
+
+        EXPECT_EQ(result.invalidPos, row.size());
+        EXPECT_EQ(result.chargerCount, 1);
+        EXPECT_EQ(result.firstCharger, 11);
+        for (size_t i = 0; i < 10; ++i) {
+            EXPECT_EQ(codes[i], i);
+        }
+        EXPECT_EQ(codes[10], MapCodec::OBSTACLE);
+        EXPECT_EQ(codes[11], MapCodec::CHARGER);
+        EXPECT_EQ(codes[12], MapCodec::UNVISITED);
+    }
+}
+
+// Test that '?' is only accepted for robot memory maps
+TEST_F(MapCodecTest, DecodeRejectsInvalidCharacters) {
+    std::string row(100, '0');
+    row[40] = 'B';
+    row[70] = '?';
+    std::vector<uint8_t> codes(row.size());
+
+    for (MapCodec::Kernel kernel : supportedKernels()) {
+        MapCodec::setKernel(kernel);
+        MapCodec::DecodeResult result = MapCodec::decodeRow(row.data(), row.size(), codes.data(), false);
+        EXPECT_EQ(result.invalidPos, 70);
+        EXPECT_EQ(result.chargerCount, 1);
+        EXPECT_EQ(result.firstCharger, 40);
+
+        row[70] = '\0';
+        result = MapCodec::decodeRow(row.data(), row.size(), codes.data(), true);
+        EXPECT_EQ(result.invalidPos, 70);
+        row[70] = '?';
+    }
+}
+
+// Test that all kernels agree with the scalar one on random rows
+TEST_F(MapCodecTest, KernelsMatchScalar) {
+    const std::string alphabet = "0123456789PB?x";
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+
+    for (size_t length : { 1, 15, 16, 31, 32, 33, 100, 1000 }) {
+        std::string row(length, '0');
+        for (char& c : row) {
+            c = alphabet[pick(gen)];
+            if (c == 'x' && pick(gen) % 4 != 0) {
+                c = '3';
+            }
+        }
+
+        std::vector<uint8_t> expectedCodes(length);
+        MapCodec::setKernel(MapCodec::Kernel::scalar);
+        MapCodec::DecodeResult expected = MapCodec::decodeRow(row.data(), length, expectedCodes.data(), true);
+
+        for (MapCodec::Kernel kernel : supportedKernels()) {
+            MapCodec::setKernel(kernel);
+            std::vector<uint8_t> codes(length);
+            MapCodec::DecodeResult result = MapCodec::decodeRow(row.data(), length, codes.data(), true);
+            EXPECT_EQ(result.invalidPos, expected.invalidPos) << MapCodec::kernelName(kernel);
+            EXPECT_EQ(result.chargerCount, expected.chargerCount) << MapCodec::kernelName(kernel);
+            EXPECT_EQ(result.firstCharger, expected.firstCharger) << MapCodec::kernelName(kernel);
+            for (size_t i = 0; i < expected.invalidPos; ++i) {
+                EXPECT_EQ(codes[i], expectedCodes[i]);
+            }
+        }
+    }
+}
+
+// Test that encoding is the inverse of decoding
+TEST_F(MapCodecTest, EncodeRoundTrip) {
+    std::string row;
+    for (int i = 0; i < 5; ++i) {
+        row += "0123456789PB?PP000";
+    }
+    std::vector<uint8_t> codes(row.size());
+    MapCodec::decodeRow(row.data(), row.size(), codes.data(), true);
+
+    for (MapCodec::Kernel kernel : supportedKernels()) {
+        MapCodec::setKernel(kernel);
+        std::string encoded(row.size(), ' ');
+        MapCodec::encodeRow(codes.data(), codes.size(), &encoded[0]);
+        EXPECT_EQ(encoded, row) << MapCodec::kernelName(kernel);
+
+        uint8_t invalid = MapCodec::INVALID;
+        char out = ' ';
+        MapCodec::encodeRow(&invalid, 1, &out);
+        EXPECT_EQ(out, '?');
+    }
+}
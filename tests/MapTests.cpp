@@ -2,11 +2,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "../Robot/Map.h"
 #include "../Robot/Floor.h"
 #include "../Robot/Obstacle.h"
 #include "../Robot/Charger.h"
 #include "../Robot/UnVisited.h"
+#include "TestMaps.h"
 
 class MapTest : public ::testing::Test {
 protected:
@@ -133,7 +140,7 @@ TEST_F(MapTest, CopyConstructor) {
         ASSERT_NE(originalTile, nullptr);
         ASSERT_NE(copiedTile, nullptr);
         EXPECT_NE(originalTile, copiedTile); // Different objects
-        EXPECT_EQ(originalTile->getId(), copiedTile->getId());
+        EXPECT_EQ(copy.getId(copiedTile), i);
     }
 }
 
@@ -208,7 +215,7 @@ TEST_F(MapTest, GetTile) {
     // Test getTile with direction
     const Tile* upTile = map.getTile(4, Direction::up);
     ASSERT_NE(upTile, nullptr);
-    EXPECT_EQ(upTile->getId(), 1);
+    EXPECT_EQ(map.getId(upTile), 1u);
 
     // Test getTile with invalid direction
     const Tile* invalidDirectionTile = map.getTile(0, Direction::up);
@@ -238,7 +245,7 @@ TEST_F(MapTest, UpdateTile) {
     Map map(3, 3, 4);
 
     // Create a dirty floor tile
-    Floor dirtyFloor(0, 5);
+    Floor dirtyFloor(5);
 
     // Update tile 0 with dirty floor
     map.updateTile(0, &dirtyFloor);
@@ -248,12 +255,48 @@ TEST_F(MapTest, UpdateTile) {
     const Floor* floorTile = dynamic_cast<const Floor*>(updatedTile);
     ASSERT_NE(floorTile, nullptr);
     EXPECT_EQ(floorTile->getCleanliness(), 5);
-    EXPECT_EQ(floorTile->getId(), 0);
+    EXPECT_EQ(map.getId(floorTile), 0u);
 
     // Test updating with invalid index
     EXPECT_THROW(map.updateTile(100, &dirtyFloor), std::out_of_range);
 }
 
+// Test that updateTile only reports and notifies real changes
+TEST_F(MapTest, UpdateTileSkipsUnchanged) {
+    Map map(3, 3, 4);
+    std::vector<std::pair<size_t, TileKind>> changes;
+    map.setTileChangeListener([&changes](size_t tileId, TileKind previousKind) {
+        changes.emplace_back(tileId, previousKind);
+    });
+
+    Floor dirtyFloor(5);
+    EXPECT_TRUE(map.updateTile(0, &dirtyFloor));
+    const Tile* floorTile = map.getTile(0);
+
+    // Same kind and dirt - nothing to do
+    EXPECT_FALSE(map.updateTile(0, &dirtyFloor));
+    Charger charger;
+    EXPECT_FALSE(map.updateTile(4, &charger));
+
+    // Same kind, different dirt - updated in place
+    Floor cleanFloor;
+    EXPECT_TRUE(map.updateTile(0, &cleanFloor));
+    EXPECT_EQ(map.getTile(0), floorTile);
+    EXPECT_EQ(map.getTile(0)->asFloor()->getCleanliness(), 0u);
+    EXPECT_EQ(map.getId(map.getTile(0)), 0u);
+
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0].first, 0u);
+    EXPECT_EQ(changes[0].second, TileKind::unvisited);
+    EXPECT_EQ(changes[1].second, TileKind::floor);
+
+    // Copies do not share the listener
+    Map copy(map);
+    Obstacle obstacle;
+    EXPECT_TRUE(copy.updateTile(1, &obstacle));
+    EXPECT_EQ(changes.size(), 2u);
+}
+
 // Test saveMap and loadMap consistency
 TEST_F(MapTest, SaveLoadConsistency) {
     std::istringstream iss(simpleMapStr);
@@ -313,7 +356,7 @@ TEST_F(MapTest, UnVisitedTiles) {
     Map map(2, 2, 0);
 
     // Update a tile to UnVisited
-    UnVisited unvisited(1);
+    UnVisited unvisited;
     map.updateTile(1, &unvisited);
 
     const Tile* tile = map.getTile(1);
@@ -379,3 +422,529 @@ TEST_F(MapTest, OutputOperator) {
     size_t lineCount = std::count(output.begin(), output.end(), '\n');
     EXPECT_EQ(lineCount, 3); // Should have 3 lines for 3x3 map
 }
+
+// Test rows longer than the parser's read buffer
+TEST_F(MapTest, StreamLongRows) {
+    const size_t rowWidth = 10000;
+    std::string mapStr;
+    for (size_t row = 0; row < 3; ++row) {
+        std::string line(rowWidth, '0');
+        if (row == 1) {
+            line[rowWidth - 1] = 'B';
+        }
+        mapStr += line + "\n";
+    }
+
+    std::istringstream iss(mapStr);
+    Map map(iss);
+
+    EXPECT_EQ(map.getWidth(), rowWidth);
+    EXPECT_EQ(map.getHeight(), 3);
+    EXPECT_EQ(map.getChargerId(), 2 * rowWidth - 1);
+    EXPECT_TRUE(map.isMapValid());
+
+    // Row longer than the first one must still be rejected
+    std::istringstream bad(std::string(rowWidth, '0') + "\n" + std::string(rowWidth + 1, 'B') + "\n");
+    EXPECT_THROW(Map badMap(bad), std::runtime_error);
+}
+
+// Test loading a map section followed by other data in the same stream
+TEST_F(MapTest, LoadMapSection) {
+    std::istringstream iss("012\n3B5\n\n4 7 0 2\n");
+    Map map;
+    map.loadMapSection(iss, false);
+
+    EXPECT_EQ(map.getWidth(), 3);
+    EXPECT_EQ(map.getHeight(), 2);
+    EXPECT_EQ(map.getChargerId(), 4);
+
+    // The rest of the stream is left untouched
+    size_t position = 0;
+    iss >> position;
+    EXPECT_EQ(position, 4);
+}
+
+// Test saving and loading the run-length encoded format
+TEST_F(MapTest, RleSaveLoad) {
+    std::istringstream iss("0000P\n00B11\n99999\n");
+    Map original(iss);
+
+    std::ostringstream oss;
+    original.saveMap(oss, MapFormat::rle);
+    EXPECT_EQ(oss.str(), "RLE 5 3\n40 1P\n20 1B 21\n59\n");
+
+    std::istringstream rleStream(oss.str());
+    Map reloaded(rleStream);
+    EXPECT_EQ(reloaded.getWidth(), 5);
+    EXPECT_EQ(reloaded.getHeight(), 3);
+    EXPECT_EQ(reloaded.getChargerId(), 7);
+
+    std::ostringstream text;
+    reloaded.saveMap(text);
+    EXPECT_EQ(text.str(), "0000P\n00B11\n99999\n");
+}
+
+// Test rejection of malformed RLE maps
+TEST_F(MapTest, RleInvalidMaps) {
+    // Run longer than the row
+    std::istringstream tooLong("RLE 3 1\n40\n");
+    EXPECT_THROW(Map map1(tooLong), std::runtime_error);
+
+    // Missing rows
+    std::istringstream missingRow("RLE 3 2\n20 1B\n");
+    EXPECT_THROW(Map map2(missingRow), std::runtime_error);
+
+    // Charger run
+    std::istringstream chargerRun("RLE 3 1\n2B 10\n");
+    EXPECT_THROW(Map map3(chargerRun), std::runtime_error);
+
+    // Unvisited tiles outside of robot memory
+    std::istringstream unvisited("RLE 3 1\n1B 2?\n");
+    EXPECT_THROW(Map map4(unvisited), std::runtime_error);
+    std::istringstream unvisitedMemory("RLE 3 1\n1B 2?\n");
+    EXPECT_NO_THROW(Map map5(unvisitedMemory, true));
+}
+
+TEST_F(MapTest, TooManyTilesForTileIndex) {
+    if (sizeof(TileIndex) == sizeof(size_t)) {
+        GTEST_SKIP() << "built with ROBOT_TILE_INDEX_64";
+    }
+    // 70000 * 70000 tiles do not fit in 32 bits; rejected before anything is allocated
+    std::istringstream huge("RLE 70000 70000\n70000B\n");
+    EXPECT_THROW(Map map1(huge), std::runtime_error);
+    EXPECT_THROW(Map map2(70000, 70000, 0), std::runtime_error);
+}
+
+// Test connected components of walkable tiles
+TEST_F(MapTest, ComponentsFollowUpdates) {
+    std::istringstream iss(
+        "00P00\n"
+        "0BP00\n"
+        "00P00\n");
+    Map map(iss);
+
+    EXPECT_TRUE(map.isReachable(0, 11));
+    EXPECT_FALSE(map.isReachable(0, 4));
+    EXPECT_TRUE(map.isReachable(3, 14));
+    EXPECT_EQ(map.getComponent(2), Map::NO_COMPONENT);
+    EXPECT_FALSE(map.isReachable(2, 2));
+    EXPECT_FALSE(map.isReachable(0, 100));
+
+    // Opening the wall joins both sides
+    Floor floor;
+    EXPECT_TRUE(map.updateTile(7, &floor));
+    EXPECT_TRUE(map.isReachable(0, 4));
+    EXPECT_EQ(map.getComponent(0), map.getComponent(14));
+
+    // Closing it again splits them
+    Obstacle obstacle;
+    EXPECT_TRUE(map.updateTile(7, &obstacle));
+    EXPECT_FALSE(map.isReachable(0, 4));
+    EXPECT_TRUE(map.isReachable(3, 14));
+
+    // Copies get their own labels
+    Map copy(map);
+    copy.updateTile(12, &floor);
+    EXPECT_TRUE(copy.isReachable(0, 4));
+    EXPECT_FALSE(map.isReachable(0, 4));
+}
+
+TEST_F(MapTest, SparseChunksCreatedOnWrite) {
+    Map map(1000, 1000, 0);
+    EXPECT_EQ(map.getChunkCount(), 256u);
+    EXPECT_EQ(map.getLoadedChunkCount(), 1u);
+    EXPECT_TRUE(map.isMapValid(true));
+
+    // Odczyt nie tworzy kawałka
+    const Map& view = map;
+    ASSERT_NE(view.getTile(999999), nullptr);
+    EXPECT_EQ(view.getTile(999999)->getKind(), TileKind::unvisited);
+    EXPECT_EQ(view.getId(view.getTile(999999)), Tile::INVALID_ID);
+    EXPECT_FALSE(map.canMoveOn(999999));
+    EXPECT_FALSE(map.isChunkLoaded(999999));
+    UnVisited unvisited;
+    EXPECT_FALSE(map.updateTile(999999, &unvisited));
+    EXPECT_EQ(map.getLoadedChunkCount(), 1u);
+
+    Floor floor(3);
+    EXPECT_TRUE(map.updateTile(999999, &floor));
+    EXPECT_TRUE(map.isChunkLoaded(999999));
+    EXPECT_EQ(map.getLoadedChunkCount(), 2u);
+    EXPECT_EQ(map.getId(map.getTile(999999)), 999999u);
+    EXPECT_EQ(view.getId(view.getTile(999998)), 999998u);
+
+    // Kopia i zapis zachowują niezapisane kawałki
+    Map copy(map);
+    EXPECT_EQ(copy.getLoadedChunkCount(), 2u);
+    std::stringstream saved;
+    map.saveMap(saved, MapFormat::rle);
+    Map loaded(saved, true);
+    EXPECT_EQ(loaded.getLoadedChunkCount(), 2u);
+    EXPECT_EQ(loaded.getTile(999999)->asFloor()->getCleanliness(), 3u);
+}
+
+TEST_F(MapTest, ComponentsAcrossChunks) {
+    std::string text(200, '0');
+    text[0] = 'B';
+    text += "\n" + std::string(200, 'P') + "\n" + std::string(200, '0') + "\n";
+    std::istringstream iss(text);
+    Map map(iss);
+    EXPECT_EQ(map.getChunkCount(), 4u);
+    EXPECT_TRUE(map.isReachable(0, 199));
+    EXPECT_FALSE(map.isReachable(0, 400));
+    EXPECT_TRUE(map.isReachable(400, 599));
+
+    // Przejście przez ścianę na granicy kawałków
+    Floor floor;
+    map.updateTile(264, &floor);
+    EXPECT_TRUE(map.isReachable(0, 599));
+}
+
+TEST(TileLayoutTest, EverySlotUsedOnce) {
+    for (size_t side : { 1, 2, 64, 256 }) {
+        std::vector<bool> rowMajor(side * side), morton(side * side);
+        for (size_t y = 0; y < side; ++y) {
+            for (size_t x = 0; x < side; ++x) {
+                const size_t a = RowMajorLayout::slot(x, y, side), b = MortonLayout::slot(x, y, side);
+                ASSERT_LT(a, side * side);
+                ASSERT_LT(b, side * side);
+                EXPECT_FALSE(rowMajor[a]);
+                EXPECT_FALSE(morton[b]);
+                rowMajor[a] = morton[b] = true;
+            }
+        }
+    }
+    EXPECT_EQ(MortonLayout::slot(1, 0, 64), 1u);
+    EXPECT_EQ(MortonLayout::slot(0, 1, 64), 2u);
+    EXPECT_EQ(MortonLayout::slot(63, 63, 64), 4095u);
+}
+
+TEST_F(MapTest, LayoutDoesNotChangeTileIds) {
+    // Kafelki na granicach kawałków i w niepełnym kawałku na brzegu mapy
+    std::string text;
+    for (size_t y = 0; y < 70; ++y) {
+        for (size_t x = 0; x < 130; ++x) {
+            text += x == 0 && y == 0 ? 'B' : static_cast<char>('0' + (x * 7 + y * 3) % 10);
+        }
+        text += "\n";
+    }
+    std::istringstream iss(text);
+    Map map(iss);
+    for (size_t id = 0; id < map.getSize(); ++id) {
+        ASSERT_EQ(map.getId(map.getTile(id)), id);
+    }
+    EXPECT_EQ(map.getTile(65 * 130 + 129)->asFloor()->getCleanliness(), (129 * 7 + 65 * 3) % 10);
+    std::ostringstream saved;
+    map.saveMap(saved);
+    EXPECT_EQ(saved.str(), text);
+}
+
+TEST_F(MapTest, WalkableNeighboursMatchGetIndex) {
+    std::istringstream iss(
+        "B0P1\n"
+        "0P00\n"
+        "1003\n");
+    Map map(iss);
+    auto neighbours = [](const Map& m, size_t tile) {
+        std::vector<size_t> found;
+        m.forEachWalkableNeighbour(tile, [&](size_t neighbour) { found.push_back(neighbour); });
+        return found;
+    };
+    auto expected = [](const Map& m, size_t tile) {
+        std::vector<size_t> found;
+        for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+            auto neighbour = m.getIndex(tile, dir);
+            if (neighbour && m.canMoveOn(*neighbour)) {
+                found.push_back(*neighbour);
+            }
+        }
+        return found;
+    };
+    for (size_t tile = 0; tile < map.getSize(); ++tile) {
+        EXPECT_EQ(neighbours(map, tile), expected(map, tile)) << tile;
+    }
+    EXPECT_EQ(neighbours(map, 5), (std::vector<size_t>{ 1, 9, 4, 6 }));   // Obstacle itself can be asked
+    EXPECT_FALSE(map.canMoveOn(12));
+
+    // Zmiany przejezdności, także przez wycofanie i w nakładce na wspólnej bazie
+    const size_t snapshot = map.snapshot();
+    Obstacle obstacle;
+    map.updateTile(1, &obstacle);
+    EXPECT_EQ(neighbours(map, 0), (std::vector<size_t>{ 4 }));
+    map.rollback(snapshot);
+    EXPECT_EQ(neighbours(map, 0), (std::vector<size_t>{ 4, 1 }));
+
+    std::shared_ptr<const Map> base = Map::share(map);
+    Map overlay(base);
+    Floor floor;
+    overlay.updateTile(5, &floor);
+    EXPECT_EQ(neighbours(overlay, 4), (std::vector<size_t>{ 0, 8, 5 }));
+    EXPECT_EQ(neighbours(*base, 4), (std::vector<size_t>{ 0, 8 }));
+    Map moved(std::move(overlay));
+    EXPECT_TRUE(moved.canMoveOn(5));
+    EXPECT_FALSE(overlay.canMoveOn(5));
+}
+
+TEST_F(MapTest, WalkableNeighboursAcrossChunks) {
+    // Sąsiedzi liczeni z rodzajów kafelków, niezależnie od siatek przejezdności
+    auto checkNeighbours = [](const Map& m) {
+        for (size_t tile = 0; tile < m.getSize(); ++tile) {
+            std::vector<size_t> found;
+            m.forEachWalkableNeighbour(tile, [&](size_t neighbour) { found.push_back(neighbour); });
+            std::vector<size_t> expected;
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                auto neighbour = m.getIndex(tile, dir);
+                if (neighbour && m.getTile(*neighbour)->isWalkable()) {
+                    expected.push_back(*neighbour);
+                }
+            }
+            ASSERT_EQ(found, expected) << tile;
+            ASSERT_EQ(m.canMoveOn(tile), m.getTile(tile)->isWalkable()) << tile;
+        }
+    };
+
+    // Wysokość podzielna przez bok kawałka i niepodzielna
+    for (size_t height : { 128u, 130u }) {
+        std::istringstream text(TestMaps::randomMapText(3, 150, height));
+        Map map(text);
+        checkNeighbours(map);
+
+        std::stringstream rle;
+        map.saveMap(rle, MapFormat::rle);
+        checkNeighbours(Map(rle));
+
+        // Pamięć robota zapisywana w losowej kolejności, siatki powstają przy pierwszym przejezdnym polu
+        Map memory(map.getWidth(), map.getHeight(), map.getChargerId());
+        std::vector<size_t> order(map.getSize());
+        for (size_t id = 0; id < order.size(); ++id) {
+            order[id] = id;
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937(7));
+        for (size_t i = 0; i < order.size(); ++i) {
+            memory.updateTile(order[i], map.getTile(order[i]));
+            if (i == order.size() / 3) {
+                checkNeighbours(memory);
+            }
+        }
+        checkNeighbours(memory);
+
+        // Zablokowanie kafelków na styku czterech kawałków w nakładce
+        std::shared_ptr<const Map> base = Map::share(memory);
+        Map overlay(base);
+        Obstacle obstacle;
+        Floor floor;
+        for (size_t tile : { 63 * 150 + 63, 63 * 150 + 64, 64 * 150 + 63, 64 * 150 + 64 }) {
+            overlay.updateTile(tile, &obstacle);
+        }
+        overlay.updateTile(64 * 150 + 64, &floor);
+        checkNeighbours(overlay);
+        checkNeighbours(*base);
+        checkNeighbours(Map(overlay));
+    }
+}
+
+TEST_F(MapTest, OverlayCopiesChunkOnWrite) {
+    std::string text;
+    for (size_t y = 0; y < 130; ++y) {
+        text += std::string(200, y == 0 ? '1' : '0') + "\n";
+    }
+    text[0] = 'B';
+    std::istringstream iss(text);
+    std::shared_ptr<const Map> base = Map::share(Map(iss));
+    ASSERT_EQ(base->getChunkCount(), 12u);
+
+    Map overlay(base);
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 0u);
+    EXPECT_TRUE(overlay.isMapValid());
+    EXPECT_EQ(overlay.getTile(5), base->getTile(5));
+    EXPECT_TRUE(overlay.isReachable(0, 25999));
+
+    // Ten sam stan nie kopiuje kawałka
+    Floor dirty(1);
+    EXPECT_FALSE(overlay.updateTile(5, &dirty));
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 0u);
+
+    Floor clean;
+    EXPECT_TRUE(overlay.updateTile(5, &clean));
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 1u);
+    EXPECT_EQ(overlay.getTile(5)->asFloor()->getCleanliness(), 0u);
+    EXPECT_EQ(overlay.getTile(70)->asFloor()->getCleanliness(), 1u);
+    EXPECT_EQ(base->getTile(5)->asFloor()->getCleanliness(), 1u);
+
+    overlay.editFloor(25999)->setCleanliness(7);
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 2u);
+    EXPECT_EQ(base->getTile(25999)->asFloor()->getCleanliness(), 0u);
+
+    // Kopia nakładki dzieli bazę
+    Map copy(overlay);
+    EXPECT_EQ(copy.getBase(), base);
+    EXPECT_EQ(copy.getLoadedChunkCount(), 2u);
+    std::ostringstream savedOverlay, savedCopy;
+    overlay.saveMap(savedOverlay);
+    copy.saveMap(savedCopy);
+    EXPECT_EQ(savedOverlay.str(), savedCopy.str());
+    EXPECT_EQ(savedOverlay.str().substr(0, 7), "B111101");
+}
+
+TEST_F(MapTest, EditFloorOnlyForWrites) {
+    std::istringstream iss("B0P0\n00P0\n00P3\n");
+    std::shared_ptr<const Map> base = Map::share(Map(iss));
+    Map overlay(base);
+
+    // Odczyty nie kopiują kawałka ani nie trafiają do dziennika
+    const size_t snapshot = overlay.snapshot();
+    EXPECT_EQ(overlay.getTile(11)->asFloor()->getCleanliness(), 3u);
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 0u);
+    EXPECT_EQ(overlay.editFloor(2), nullptr);
+    EXPECT_EQ(overlay.editFloor(0), nullptr);
+    EXPECT_EQ(overlay.editFloor(12), nullptr);
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 0u);
+
+    overlay.editFloor(11)->setCleanliness(0);
+    EXPECT_EQ(overlay.getLoadedChunkCount(), 1u);
+    overlay.rollback(snapshot);
+    EXPECT_EQ(overlay.getTile(11)->asFloor()->getCleanliness(), 3u);
+    EXPECT_EQ(base->getTile(11)->asFloor()->getCleanliness(), 3u);
+}
+
+TEST_F(MapTest, OverlayWalkabilityChangeCopiesBase) {
+    std::istringstream iss("B0P0\n00P0\n00P0\n");
+    std::shared_ptr<const Map> base = Map::share(Map(iss));
+    Map overlay(base);
+    EXPECT_FALSE(overlay.isReachable(0, 3));
+
+    Floor floor;
+    overlay.updateTile(6, &floor);
+    EXPECT_EQ(overlay.getBase(), nullptr);
+    EXPECT_TRUE(overlay.isReachable(0, 3));
+    EXPECT_FALSE(base->isReachable(0, 3));
+    EXPECT_EQ(base->getTile(6)->getKind(), TileKind::obstacle);
+
+    EXPECT_THROW(Map(std::shared_ptr<const Map>()), std::runtime_error);
+}
+
+TEST_F(MapTest, OverlaysOnManyThreads) {
+    std::string text;
+    for (size_t y = 0; y < 100; ++y) {
+        text += std::string(100, y % 10 == 5 ? 'P' : '3') + "\n";
+    }
+    text[0] = 'B';
+    std::istringstream iss(text);
+    std::shared_ptr<const Map> base = Map::share(Map(iss));
+
+    std::vector<size_t> cleaned(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < cleaned.size(); ++t) {
+        threads.emplace_back([&, t] {
+            Map overlay(base);
+            for (size_t tile = t + 1; tile < overlay.getSize(); tile += 7) {
+                if (overlay.isReachable(0, tile)) {
+                    overlay.editFloor(tile)->setCleanliness(0);
+                    cleaned[t]++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < cleaned.size(); ++t) {
+        EXPECT_GT(cleaned[t], 0u);
+    }
+    EXPECT_EQ(base->getTile(1)->asFloor()->getCleanliness(), 3u);
+}
+
+TEST_F(MapTest, SnapshotRollbackRestoresTiles) {
+    std::istringstream iss("B0P0\n00P0\n00P3\n");
+    Map map(iss);
+    EXPECT_FALSE(map.isReachable(0, 3));
+    size_t changes = 0;
+    map.setTileChangeListener([&](size_t, TileKind) { changes++; });
+
+    const size_t outer = map.snapshot();
+    Floor floor(5);
+    map.updateTile(1, &floor);
+    map.updateTile(6, &floor);
+    EXPECT_TRUE(map.isReachable(0, 3));
+    const size_t inner = map.snapshot();
+    map.editFloor(11)->setCleanliness(0);
+    map.editFloor(11)->setCleanliness(9);
+    Obstacle obstacle;
+    map.updateTile(1, &obstacle);
+
+    map.rollback(inner);
+    EXPECT_EQ(map.getTile(11)->asFloor()->getCleanliness(), 3u);
+    EXPECT_EQ(map.getTile(1)->asFloor()->getCleanliness(), 5u);
+
+    map.rollback(outer);
+    EXPECT_EQ(map.getTile(1)->asFloor()->getCleanliness(), 0u);
+    EXPECT_EQ(map.getTile(6)->getKind(), TileKind::obstacle);
+    EXPECT_FALSE(map.isReachable(0, 3));
+    EXPECT_GT(changes, 4u);
+
+    std::ostringstream saved;
+    map.saveMap(saved);
+    EXPECT_EQ(saved.str(), "B0P0\n00P0\n00P3\n");
+
+    // Kolejne gałęzie z tego samego miejsca
+    map.editFloor(3)->setCleanliness(7);
+    map.rollback(outer);
+    EXPECT_EQ(map.getTile(3)->asFloor()->getCleanliness(), 0u);
+
+    std::istringstream other("B0\n");
+    map.loadMap(other);
+    EXPECT_FALSE(map.hasSnapshot());
+    EXPECT_THROW(map.rollback(outer), std::runtime_error);
+}
+
+namespace {
+    // Liczy żywe alokacje, przekazując je do zwykłej sterty
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t live = 0;
+        size_t total = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            live++;
+            total++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            live--;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+}
+
+// Tiles come from the caller's resource and every one of them is given back
+TEST_F(MapTest, TilesUseCallerResource) {
+    CountingResource resource;
+    {
+        Map map(&resource);
+        std::istringstream iss("B0P\n000\n");
+        map.loadMap(iss);
+        EXPECT_EQ(resource.live, 6u);
+
+        const size_t snapshot = map.snapshot();
+        Obstacle obstacle;
+        map.updateTile(1, &obstacle);
+        map.rollback(snapshot);
+        EXPECT_EQ(resource.live, 6u);
+
+        // Kopia wraca do własnej puli
+        Map copy(map);
+        EXPECT_EQ(resource.live, 6u);
+        EXPECT_EQ(copy.getTile(2)->getKind(), TileKind::obstacle);
+
+        std::istringstream smaller("B\n");
+        map.loadMap(smaller);
+        EXPECT_EQ(resource.live, 1u);
+
+        Map moved(std::move(map));
+        EXPECT_EQ(moved.getTile(0)->getKind(), TileKind::charger);
+    }
+    EXPECT_EQ(resource.live, 0u);
+    EXPECT_GT(resource.total, 7u);
+}
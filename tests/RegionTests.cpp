@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "../Robot/Region.h"
+
+namespace {
+    // Tiles of the region on a width x height map, row by row
+    std::vector<size_t> tilesOf(const Region& region, size_t width, size_t height) {
+        std::vector<size_t> tiles;
+        region.forEachSpan(width, height, [&](size_t row, size_t first, size_t last) {
+            for (size_t x = first; x <= last; ++x) {
+                tiles.push_back(row * width + x);
+            }
+        });
+        return tiles;
+    }
+}
+
+TEST(RegionTest, RectSpansAreClippedToMap) {
+    Region region = Region::rect(3, 2, -1, 0);
+    EXPECT_EQ(region.left(), -1);
+    EXPECT_EQ(region.bottom(), 2);
+
+    // 3x2 map: region keeps columns 0-2 of both rows
+    EXPECT_EQ(tilesOf(region, 3, 2), (std::vector<size_t>{ 0, 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(region.tileCount(10, 10), 12u);
+    EXPECT_EQ(Region::rect(20, 20, 30, 30).tileCount(10, 10), 0u);
+}
+
+TEST(RegionTest, PolygonContainsTileCentres) {
+    // Triangle with a vertical and a horizontal leg
+    Region triangle = Region::polygon({ { 0, 0 }, { 4, 4 }, { 0, 4 } });
+    EXPECT_TRUE(triangle.contains(0, 0));
+    EXPECT_TRUE(triangle.contains(2, 2));
+    EXPECT_TRUE(triangle.contains(4, 4));
+    EXPECT_FALSE(triangle.contains(3, 2));
+    EXPECT_FALSE(triangle.contains(5, 4));
+    EXPECT_EQ(triangle.tileCount(10, 10), 15u);
+
+    // Rectangle as a polygon covers the same tiles as rect()
+    Region square = Region::polygon({ { 1, 1 }, { 3, 1 }, { 3, 3 }, { 1, 3 } });
+    EXPECT_EQ(tilesOf(square, 5, 5), tilesOf(Region::rect(1, 1, 3, 3), 5, 5));
+
+    EXPECT_THROW(Region::polygon({ { 0, 0 }, { 1, 1 } }), std::runtime_error);
+}
+
+TEST(RegionTest, ConcavePolygonSplitsRows) {
+    // U shape: columns 0 and 4 rise above the bottom bar
+    Region shape = Region::polygon({ { 0, 0 }, { 1, 0 }, { 1, 3 }, { 3, 3 }, { 3, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 } });
+    std::vector<Region::Span> spans;
+    shape.rowSpans(1, spans);
+    EXPECT_EQ(spans, (std::vector<Region::Span>{ { 0, 1 }, { 3, 4 } }));
+    shape.rowSpans(3, spans);
+    EXPECT_EQ(spans, (std::vector<Region::Span>{ { 0, 4 } }));
+    shape.rowSpans(5, spans);
+    EXPECT_TRUE(spans.empty());
+}
+
+TEST(ZoneSetTest, LoadSaveRoundTrip) {
+    std::istringstream iss(
+        "# kitchen and hall\n"
+        "kitchen rect 0 0 4 2\n"
+        "\n"
+        "hall polygon 0 0 5 0 0 5\n");
+    ZoneSet zones;
+    zones.load(iss);
+    ASSERT_EQ(zones.size(), 2u);
+    ASSERT_NE(zones.find("kitchen"), nullptr);
+    EXPECT_EQ(*zones.find("kitchen"), Region::rect(0, 0, 4, 2));
+    EXPECT_EQ(zones.find("hall")->getShape(), Region::Shape::polygon);
+    EXPECT_EQ(zones.find("garage"), nullptr);
+
+    std::ostringstream oss;
+    zones.save(oss);
+    EXPECT_EQ(oss.str(), "kitchen rect 0 0 4 2\nhall polygon 0 0 5 0 0 5\n");
+
+    zones.set("kitchen", Region::rect(1, 1, 2, 2));
+    EXPECT_EQ(zones.size(), 2u);
+    EXPECT_EQ(*zones.find("kitchen"), Region::rect(1, 1, 2, 2));
+    EXPECT_TRUE(zones.remove("hall"));
+    EXPECT_FALSE(zones.remove("hall"));
+    EXPECT_EQ(ZoneSet::sidecarPath("maps/office.txt"), std::filesystem::path("maps/office.txt.zones"));
+}
+
+TEST(ZoneSetTest, LoadRejectsMalformedLines) {
+    for (const char* text : { "a rect 0 0 1\n", "a circle 0 0 1 1\n", "a polygon 0 0 1 1\n",
+        "a rect 0 0 1 x\n", "a rect 0 0 1 1\na rect 1 1 2 2\n" }) {
+        std::istringstream iss(text);
+        ZoneSet zones;
+        EXPECT_THROW(zones.load(iss), std::runtime_error) << text;
+    }
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../Robot/RobotPath.h"
+
+// 4x3 grid:
+//  0  1  2  3
+//  4  5  6  7
+//  8  9 10 11
+class RobotPathTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path.reset(5, 4, 12);
+    }
+
+    RobotPath path;
+};
+
+TEST_F(RobotPathTest, PushAndIterate) {
+    EXPECT_TRUE(path.empty());
+    EXPECT_EQ(path.back(), 5u);
+
+    for (size_t tile : { 6u, 2u, 1u, 0u, 4u, 8u }) {
+        EXPECT_TRUE(path.push(tile));
+    }
+    EXPECT_EQ(path.size(), 6u);
+    EXPECT_EQ(path.front(), 6u);
+    EXPECT_EQ(path.back(), 8u);
+    EXPECT_EQ(path.frontDirection(), Direction::right);
+
+    std::vector<size_t> tiles(path.begin(), path.end());
+    EXPECT_EQ(tiles, (std::vector<size_t>{ 6, 2, 1, 0, 4, 8 }));
+}
+
+TEST_F(RobotPathTest, RejectsNonNeighbours) {
+    EXPECT_FALSE(path.push(5));   // Same tile
+    EXPECT_FALSE(path.push(7));   // Two tiles away
+    EXPECT_FALSE(path.push(12));  // Outside the map
+    EXPECT_TRUE(path.push(4));
+    EXPECT_FALSE(path.push(3));   // Would wrap to the previous row
+    EXPECT_TRUE(path.push(8));
+    EXPECT_FALSE(path.push(12));  // Below the last row
+    EXPECT_EQ(path.size(), 2u);
+}
+
+TEST_F(RobotPathTest, PopAdvancesStart) {
+    path.push(9);
+    path.push(10);
+    path.push(6);
+
+    EXPECT_EQ(path.frontDirection(), Direction::down);
+    path.pop();
+    EXPECT_EQ(path.getStart(), 9u);
+    EXPECT_EQ(path.front(), 10u);
+    EXPECT_EQ(path.frontDirection(), Direction::right);
+    path.pop();
+    EXPECT_EQ(path.frontDirection(), Direction::up);
+    path.pop();
+    EXPECT_TRUE(path.empty());
+    EXPECT_EQ(path.getStart(), 6u);
+    EXPECT_EQ(path.frontDirection(), Direction::none);
+}
+
+TEST_F(RobotPathTest, RingBufferWrapsAndGrows) {
+    // Moves back and forth between 5 and 6 popping as it goes, so the buffer wraps many times
+    size_t expectedFront = 6;
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(path.push(path.back() == 5 ? 6 : 5));
+        if (i % 3 == 2) {
+            EXPECT_EQ(path.front(), expectedFront);
+            path.pop();
+            expectedFront = expectedFront == 5 ? 6 : 5;
+        }
+    }
+    size_t steps = 0;
+    size_t previous = path.getStart();
+    for (size_t tile : path) {
+        EXPECT_TRUE(tile == 5 || tile == 6);
+        EXPECT_NE(tile, previous);
+        previous = tile;
+        steps++;
+    }
+    EXPECT_EQ(steps, path.size());
+    EXPECT_EQ(previous, path.back());
+}
+
+TEST_F(RobotPathTest, CompactMemory) {
+    RobotPath longPath;
+    longPath.reset(0, 4096, 4096 * 4096);
+    for (size_t tile = 1; tile < 4096; ++tile) {
+        longPath.push(tile);
+    }
+    // 2 bits per step instead of 8 bytes per tile id
+    EXPECT_LE(longPath.memoryBytes(), 4096u / 4);
+}
@@ -124,7 +124,7 @@ TEST_F(RobotTest, ExploreTile) {
     Robot robot(3, 3, 4);
 
     // Explore a dirty floor tile
-    Floor dirtyFloor(0, 5);
+    Floor dirtyFloor(5);
     robot.exploreTile(0, &dirtyFloor);
 
     // Check if robot's memory was updated
@@ -182,7 +182,7 @@ TEST_F(RobotTest, ResetMemory) {
     Robot robot(3, 3, 4);
 
     // Add some memory by exploring a tile
-    Floor dirtyFloor(0, 5);
+    Floor dirtyFloor(5);
     robot.exploreTile(0, &dirtyFloor);
 
     // Reset memory
@@ -221,7 +221,7 @@ TEST_F(RobotTest, MakeActionCleanDirtyTile) {
     Robot robot(3, 3, 4);
 
     // Explore and make current position dirty
-    Floor dirtyFloor(4, 5);
+    Floor dirtyFloor(5);
     robot.exploreTile(4, &dirtyFloor);
 
     auto [action, direction] = robot.makeAction();
@@ -236,11 +236,11 @@ TEST_F(RobotTest, MakeActionWithObstacles) {
     Robot robot(3, 3, 4);
 
     // Add an obstacle to robot's memory
-    Obstacle obstacle(1);
+    Obstacle obstacle;
     robot.exploreTile(1, &obstacle);
 
     // Add a clean floor
-    Floor cleanFloor(0, 0);
+    Floor cleanFloor;
     robot.exploreTile(0, &cleanFloor);
 
     // Robot should be able to work around obstacles
@@ -256,7 +256,7 @@ TEST_F(RobotTest, MakeActionErrorConditions) {
     Robot robot(3, 3, 4);
 
     // Place robot on obstacle in memory (this should cause error)
-    Obstacle obstacle(4);
+    Obstacle obstacle;
     robot.exploreTile(4, &obstacle);
 
     // makeAction should throw because robot is on invalid tile
@@ -270,7 +270,7 @@ TEST_F(RobotTest, SaveLoadConsistency) {
     // Modify robot state
     originalRobot.setPosition(1);
     originalRobot.setEfficiency(7);
-    Floor dirtyFloor(0, 3);
+    Floor dirtyFloor(3);
     originalRobot.exploreTile(0, &dirtyFloor);
     originalRobot.orderToMove(2);
 
@@ -297,7 +297,7 @@ TEST_F(RobotTest, PathfindingUnreachable) {
 
     // Create a map where target is unreachable due to obstacles
     // Surround position 0 with obstacles
-    Obstacle obs1(1), obs2(3);
+    Obstacle obs1, obs2;
     robot.exploreTile(1, &obs1);
     robot.exploreTile(3, &obs2);
 
@@ -315,7 +315,7 @@ TEST_F(RobotTest, CleaningEfficiencyCalculation) {
 
     // Test cleaning efficiency with different dirt levels
     for (unsigned int dirtLevel = 0; dirtLevel <= 9; ++dirtLevel) {
-        Floor floor(4, dirtLevel);
+        Floor floor(dirtLevel);
         robot.exploreTile(4, &floor);
 
         auto [action, direction] = robot.makeAction();
@@ -335,9 +335,9 @@ TEST_F(RobotTest, MemoryManagement) {
     Robot robot(3, 3, 4);
 
     // Test exploring different tile types
-    Floor floor(0, 3);
-    Obstacle obstacle(1);
-    Charger charger(2);
+    Floor floor(3);
+    Obstacle obstacle;
+    Charger charger;
 
     robot.exploreTile(0, &floor);
     robot.exploreTile(1, &obstacle);
@@ -425,10 +425,10 @@ TEST_F(RobotTest, CompletelyExploredMap) {
     // Explore all tiles as clean floors
     for (size_t i = 0; i < 4; ++i) {
         if (i == 0) {
-            Charger charger(i);
+            Charger charger;
             robot.exploreTile(i, &charger);
         } else {
-            Floor floor(i, 0);
+            Floor floor;
             robot.exploreTile(i, &floor);
         }
     }
@@ -451,3 +451,273 @@ TEST_F(RobotTest, CompletelyExploredMap) {
     // Should eventually reach completion or error state
     EXPECT_TRUE(robot.isRobotValid());
 }
+
+// Test tiles to check are counted, queried around the robot and saved
+TEST_F(RobotTest, TilesToCheckQueries) {
+    std::istringstream iss(
+        "012\n345\n6B8\n\n"
+        "0 7 1 0 "
+        "9 "
+        "0 1 0 0 0 0 0 0 1 "
+        "0\n");
+    Robot robot(iss);
+
+    EXPECT_EQ(robot.getTilesToCheckCount(), 2u);
+    EXPECT_EQ(robot.getTilesToCheckNear(1), std::vector<size_t>{ 1 });
+    EXPECT_EQ(robot.getTilesToCheckNear(2).size(), 2u);
+
+    std::ostringstream oss;
+    robot.saveRobot(oss);
+    std::istringstream reload(oss.str());
+    Robot loaded(reload);
+    EXPECT_EQ(loaded.getTilesToCheckCount(), 2u);
+    EXPECT_EQ(loaded.getTilesToCheckNear(2), robot.getTilesToCheckNear(2));
+
+    EXPECT_TRUE(robot.orderToMove(4));
+    EXPECT_EQ(robot.getTilesToCheckCount(), 0u);
+    EXPECT_TRUE(robot.getTilesToCheckNear(2).empty());
+}
+
+// Test path is saved element by element and must be continuous when loaded
+TEST_F(RobotTest, PathSaveLoad) {
+    std::istringstream iss(robotSaveData);
+    Robot robot(iss);
+    EXPECT_EQ(std::vector<size_t>(robot.getPath().begin(), robot.getPath().end()), (std::vector<size_t>{ 5, 8 }));
+
+    std::ostringstream oss;
+    robot.saveRobot(oss);
+    EXPECT_NE(oss.str().find(" 2 5 8 \n"), std::string::npos);
+
+    std::istringstream broken(
+        "012\n345\n6B8\n\n"
+        "4 7 0 2 "
+        "9 "
+        "0 0 0 0 0 0 0 0 0 "
+        "2 5 0\n");
+    EXPECT_THROW(Robot invalid(broken), std::runtime_error);
+}
+
+// ========== TRACE COMPARISON ==========
+// Expected traces were recorded from the recursive makeAction before it became a state machine.
+// Each step is "<action><direction>:<position>:<task>", an error ends the trace as "E(<message>)".
+
+namespace {
+    const char* TRACE_WORLD =
+        "PPPPPPPPPP\n"
+        "P0030P0090\n"
+        "P0B00P0000\n"
+        "P0000P0PP0\n"
+        "P5000000P0\n"
+        "PPP0PPP0P0\n"
+        "P0000200P0\n"
+        "P00P00000P\n";
+
+    // Runs the robot against a world map the same way Simulation does:
+    // sense the current tile and its neighbours, act, then apply cleaning to the world.
+    std::string recordTrace(Map world, Robot& robot, int steps) {
+        std::string trace;
+        for (int i = 0; i < steps; ++i) {
+            size_t position = robot.getPosition();
+            robot.exploreTile(position, world.getTile(position));
+            for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right }) {
+                if (auto neighbour = world.getIndex(position, dir)) {
+                    robot.exploreTile(*neighbour, world.getTile(*neighbour));
+                }
+            }
+
+            try {
+                auto [action, direction] = robot.makeAction();
+                trace += std::to_string(static_cast<int>(action)) + std::to_string(static_cast<int>(direction))
+                    + ":" + std::to_string(robot.getPosition()) + ":" + std::to_string(static_cast<int>(robot.getCurrTask())) + " ";
+                if (action == RobotAction::clean) {
+                    world.editFloor(robot.getPosition())->getCleaned(robot.getCleaningEfficiency());
+                }
+                if (action == RobotAction::none) {
+                    break;
+                }
+            }
+            catch (const std::runtime_error& e) {
+                std::string message = e.what();
+                trace += "E(" + message.substr(0, message.size() - 1) + ")";
+                break;
+            }
+        }
+        return trace;
+    }
+
+    // Robot that remembers the whole world, standing on the charger
+    std::string traceRobotSave(int task, const std::string& path = "0") {
+        std::string save = std::string(TRACE_WORLD) + "\n22 22 " + std::to_string(task) + " 0 80";
+        for (int i = 0; i < 80; ++i) {
+            save += " 0";
+        }
+        return save + " " + path + "\n";
+    }
+}
+
+class RobotTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::istringstream iss(TRACE_WORLD);
+        world.loadMap(iss);
+    }
+
+    Map world;
+};
+
+TEST_F(RobotTraceTest, UnexploredRobotStopsAtCharger) {
+    Robot robot(world.getWidth(), world.getHeight(), world.getChargerId());
+    EXPECT_EQ(recordTrace(world, robot, 300), "34:22:3 ");
+}
+
+TEST_F(RobotTraceTest, CleanEfficiently) {
+    // Follows the coverage sweep instead of the recorded hops between tiles to check
+    std::istringstream iss(traceRobotSave(1));
+    Robot robot(iss);
+    robot.orderToCleanEfficiently();
+    EXPECT_EQ(recordTrace(world, robot, 300),
+        "00:12:0 01:22:0 01:32:0 01:42:0 02:41:0 14:41:0 00:31:0 00:21:0 00:11:0 03:12:0 03:13:0 14:13:0 "
+        "01:23:0 01:33:0 01:43:0 01:53:0 01:63:0 02:62:0 01:72:0 02:71:0 00:61:0 03:62:0 03:63:0 03:64:0 "
+        "01:74:0 03:75:0 00:65:0 14:65:0 03:66:0 01:76:0 03:77:0 00:67:0 00:57:0 00:47:0 01:57:0 01:67:0 "
+        "01:77:0 03:78:0 02:77:0 00:67:0 00:57:0 00:47:0 02:46:0 00:36:0 00:26:0 00:16:0 01:26:0 01:36:0 "
+        "01:46:0 02:45:0 02:44:0 00:34:0 00:24:0 00:14:0 01:24:0 01:34:0 01:44:0 03:45:0 03:46:0 00:36:0 "
+        "00:26:0 03:27:0 00:17:0 03:18:0 14:18:0 01:28:0 03:29:0 00:19:0 01:29:0 01:39:0 01:49:0 01:59:0 "
+        "01:69:0 00:59:1 00:49:1 00:39:1 00:29:1 02:28:1 02:27:1 02:26:1 01:36:1 01:46:1 02:45:1 02:44:1 "
+        "00:34:1 00:24:1 02:23:1 02:22:1 34:22:3 ");
+}
+
+TEST_F(RobotTraceTest, CleanInRadius) {
+    std::istringstream iss(traceRobotSave(1));
+    Robot robot(iss);
+    ASSERT_TRUE(robot.orderToClean(61, 3));
+    EXPECT_EQ(recordTrace(world, robot, 300),
+        "01:32:0 01:42:0 03:43:0 01:53:0 01:63:0 02:62:0 02:61:0 03:62:1 03:63:1 03:64:1 03:65:1 14:65:1 "
+        "02:64:1 02:63:1 00:53:1 00:43:1 02:42:1 02:41:1 14:41:1 00:31:1 00:21:1 00:11:1 03:12:1 03:13:1 "
+        "14:13:1 01:23:1 01:33:1 01:43:1 03:44:1 03:45:1 03:46:1 00:36:1 00:26:1 00:16:1 03:17:1 03:18:1 "
+        "14:18:1 01:28:1 02:27:1 02:26:1 01:36:1 01:46:1 02:45:1 02:44:1 02:43:1 01:53:1 01:63:1 02:62:1 "
+        "01:72:1 00:62:1 03:63:1 00:53:1 00:43:1 00:33:1 00:23:1 02:22:1 34:22:3 ");
+}
+
+TEST_F(RobotTraceTest, MoveReplansAroundNewObstacle) {
+    std::istringstream iss(traceRobotSave(1));
+    Robot robot(iss);
+    ASSERT_TRUE(robot.orderToMove(78));
+    Obstacle obstacle;
+    world.updateTile(43, &obstacle);
+    EXPECT_EQ(recordTrace(world, robot, 300),
+        "01:32:0 01:42:0 00:32:0 03:33:0 03:34:0 01:44:0 03:45:0 03:46:0 03:47:0 01:57:0 01:67:0 01:77:0 "
+        "03:78:0 02:77:1 00:67:1 02:66:1 02:65:1 14:65:1 03:66:1 03:67:1 00:57:1 00:47:1 02:46:1 00:36:1 "
+        "00:26:1 00:16:1 03:17:1 03:18:1 14:18:1 01:28:1 02:27:1 02:26:1 01:36:1 01:46:1 02:45:1 02:44:1 "
+        "00:34:1 00:24:1 00:14:1 02:13:1 14:13:1 01:23:1 01:33:1 02:32:1 01:42:1 02:41:1 14:41:1 00:31:1 "
+        "00:21:1 03:22:1 34:22:3 ");
+}
+
+TEST_F(RobotTraceTest, MoveTargetBecomesUnreachable) {
+    std::istringstream iss(traceRobotSave(1));
+    Robot robot(iss);
+    ASSERT_TRUE(robot.orderToMove(71));
+    Obstacle obstacle;
+    world.updateTile(53, &obstacle);
+    world.updateTile(57, &obstacle);
+    EXPECT_EQ(recordTrace(world, robot, 300),
+        "01:32:0 01:42:0 03:43:0 03:44:0 03:45:0 03:46:0 03:47:0 E(Can't reach tile ID: 57)");
+}
+
+TEST_F(RobotTraceTest, RobotOnObstacle) {
+    Robot robot(world.getWidth(), world.getHeight(), world.getChargerId());
+    robot.setPosition(0);
+    EXPECT_EQ(recordTrace(world, robot, 5), "E(Robot is on invalid tile)");
+}
+
+TEST_F(RobotTraceTest, SavedPathIntoWall) {
+    std::istringstream iss(traceRobotSave(0, "3 23 24 25"));
+    Robot robot(iss);
+    EXPECT_EQ(recordTrace(world, robot, 300), "03:23:0 03:24:0 E(Can't reach tile ID: 25)");
+}
+
+TEST_F(RobotTraceTest, ExploreWithKnownMap) {
+    std::istringstream iss(traceRobotSave(2));
+    Robot robot(iss);
+    EXPECT_EQ(recordTrace(world, robot, 300),
+        "00:12:1 03:13:1 14:13:1 01:23:1 01:33:1 01:43:1 02:42:1 02:41:1 14:41:1 03:42:1 03:43:1 01:53:1 "
+        "01:63:1 03:64:1 03:65:1 14:65:1 03:66:1 03:67:1 00:57:1 00:47:1 02:46:1 00:36:1 00:26:1 00:16:1 "
+        "03:17:1 03:18:1 14:18:1 01:28:1 02:27:1 02:26:1 01:36:1 01:46:1 02:45:1 02:44:1 00:34:1 00:24:1 "
+        "02:23:1 02:22:1 34:22:3 ");
+}
+
+TEST_F(RobotTraceTest, StepReportsErrorsWithoutThrowing) {
+    Robot robot(world.getWidth(), world.getHeight(), world.getChargerId());
+    robot.setPosition(0);
+
+    RobotStep result;
+    EXPECT_NO_THROW(result = robot.step());
+    EXPECT_EQ(result.error, RobotError::invalidTile);
+    EXPECT_EQ(result.errorTile, 0u);
+    EXPECT_EQ(Robot::errorMessage(result), "Robot is on invalid tile\n");
+
+    robot.setPosition(world.getChargerId());
+    result = robot.step();
+    EXPECT_EQ(result.error, RobotError::none);
+    EXPECT_EQ(result.action, RobotAction::none);
+}
+
+TEST_F(RobotTraceTest, SnapshotRollbackReplaysSameTrace) {
+    std::istringstream iss(traceRobotSave(2));
+    Robot robot(iss);
+    std::ostringstream before;
+    robot.saveRobot(before);
+
+    const RobotSnapshot snapshot = robot.snapshot();
+    const std::string first = recordTrace(world, robot, 300);
+    EXPECT_NE(first.find("14:"), std::string::npos);
+    robot.rollback(snapshot);
+    std::ostringstream after;
+    robot.saveRobot(after);
+    EXPECT_EQ(after.str(), before.str());
+    EXPECT_EQ(recordTrace(world, robot, 300), first);
+
+    robot.rollback(snapshot);
+    robot.commit();
+    EXPECT_THROW(robot.rollback(snapshot), std::runtime_error);
+}
+
+// Test cleaning orders for a rectangle of the memory map
+TEST_F(RobotTest, OrderToCleanRegion) {
+    std::istringstream iss(
+        "0000P000\n"
+        "0B00P000\n"
+        "0000P000\n");
+    Map known(iss);
+    Robot robot(8, 3, 9);
+    for (size_t id = 0; id < known.getSize(); ++id) {
+        robot.exploreTile(id, known.getTile(id));
+    }
+
+    // Rectangle over the wall: only the robot's side is marked
+    EXPECT_TRUE(robot.orderToCleanRegion(Region::rect(2, 0, 6, 1)));
+    EXPECT_EQ(robot.getCurrTask(), RobotAction::move);
+    EXPECT_EQ(robot.getTilesToCheckCount(), 4u);
+    EXPECT_FALSE(robot.getPath().empty());
+
+    // Nothing reachable behind the wall
+    EXPECT_FALSE(robot.orderToCleanRegion(Region::rect(5, 0, 7, 2)));
+    EXPECT_EQ(robot.getTilesToCheckCount(), 0u);
+}
+
+// The tile under the robot does not end the search with an empty path
+TEST_F(RobotTest, OrderToCleanRegionFromInside) {
+    std::istringstream iss(
+        "0000P000\n"
+        "0B00P000\n"
+        "0000P000\n");
+    Map known(iss);
+    Robot robot(8, 3, 9);
+    for (size_t id = 0; id < known.getSize(); ++id) {
+        robot.exploreTile(id, known.getTile(id));
+    }
+
+    EXPECT_TRUE(robot.orderToCleanRegion(Region::rect(1, 1, 2, 1)));
+    EXPECT_EQ(robot.getTilesToCheckCount(), 1u);
+    ASSERT_FALSE(robot.getPath().empty());
+    EXPECT_EQ(robot.getPath().back(), 10u);
+}
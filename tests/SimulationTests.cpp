@@ -108,6 +108,51 @@ TEST_F(SimulationTest, LoadInvalidMapFile) {
     EXPECT_NO_THROW(sim.loadFromFile(invalidFile));
 }
 
+TEST_F(SimulationTest, LoadFromStream) {
+    std::istringstream mapOnly(simpleMapStr);
+    Simulation sim;
+    sim.loadFromStream(mapOnly);
+    EXPECT_EQ(sim.getMap().getWidth(), 3u);
+    EXPECT_EQ(sim.getMap().getHeight(), 3u);
+    EXPECT_EQ(sim.getMap().getChargerId(), 7u);
+    EXPECT_EQ(sim.getMap().getTile(5)->asFloor()->getCleanliness(), 5u);
+    // Bez danych robota: robot na ładowarce, z pustą pamięcią
+    EXPECT_EQ(sim.getRobot().getPosition(), 7u);
+    EXPECT_EQ(sim.getRobot().getMemoryMap().getTile(5)->getKind(), TileKind::unvisited);
+
+    // Mapa świata, pamięć robota i jego stan
+    std::istringstream fullSave("912\n3P5\n6B8\n\n"
+        "9?2\n???\n6B?\n\n"
+        "6 7 0 2 9 0 0 0 0 0 0 0 0 0 0\n");
+    sim.loadFromStream(fullSave);
+    EXPECT_EQ(sim.getMap().getTile(0)->asFloor()->getCleanliness(), 9u);
+    EXPECT_EQ(sim.getMap().getTile(4)->getKind(), TileKind::obstacle);
+    const Robot& robot = sim.getRobot();
+    EXPECT_EQ(robot.getPosition(), 6u);
+    EXPECT_EQ(robot.getChargerId(), 7u);
+    EXPECT_EQ(robot.getCleaningEfficiency(), 2u);
+    EXPECT_EQ(robot.getMemoryMap().getTile(0)->asFloor()->getCleanliness(), 9u);
+    EXPECT_EQ(robot.getMemoryMap().getTile(4)->getKind(), TileKind::unvisited);
+}
+
+TEST_F(SimulationTest, LoadRleSimulation) {
+    fs::path rleFile = testDir / "office.rle";
+    std::ofstream(rleFile) << "RLE 3 3\n30\n10 1B 10\n3P\n\n"
+        "RLE 3 3\n3?\n1? 1B 1?\n3?\n\n"
+        "4 4 2 0 9 0 0 0 0 0 0 0 0 0 0\n";
+
+    Simulation sim;
+    sim.loadFromFile(rleFile);
+    std::ostringstream world;
+    sim.getMap().saveMap(world);
+    EXPECT_EQ(world.str(), "000\n0B0\nPPP\n");
+    std::ostringstream memory;
+    sim.getRobot().getMemoryMap().saveMap(memory);
+    EXPECT_EQ(memory.str(), "???\n?B?\n???\n");
+    EXPECT_EQ(sim.getRobot().getPosition(), 4u);
+    EXPECT_EQ(sim.getRobot().getCurrTask(), static_cast<RobotAction>(2));
+}
+
 // ========== SIMULATION VALIDATION TESTS ==========
 
 TEST_F(SimulationTest, SimulationValidationWithValidState) {
@@ -137,6 +182,21 @@ TEST_F(SimulationTest, StartWithEmptyPath) {
     EXPECT_NO_THROW(Simulation(3, 3, 4));
 }
 
+TEST_F(SimulationTest, SnapshotRollback) {
+    Simulation sim(3, 3, 4);
+    SimulationSnapshot snapshot = sim.snapshot();
+    EXPECT_NO_THROW(sim.rollback(snapshot));
+    sim.commit();
+    EXPECT_THROW(sim.rollback(snapshot), std::runtime_error);
+}
+
+TEST_F(SimulationTest, ConstructWithSharedMap) {
+    std::istringstream iss("B00\n0P0\n000\n");
+    std::shared_ptr<const Map> base = Map::share(Map(iss));
+    EXPECT_NO_THROW(Simulation{ base });
+    EXPECT_THROW(Simulation{ std::shared_ptr<const Map>() }, std::runtime_error);
+}
+
 // ========== FILE I/O CONSISTENCY TESTS ==========
 
 TEST_F(SimulationTest, SaveLoadConsistency) {
@@ -155,6 +215,50 @@ TEST_F(SimulationTest, SaveLoadConsistency) {
     EXPECT_TRUE(fs::exists(mapFile));
 }
 
+TEST_F(SimulationTest, SaveWithoutZonesRemovesSidecar) {
+    fs::path zonedMap = testDir / "zoned_map.txt";
+    std::ofstream(zonedMap) << "012\n345\n6B8\n";
+    std::ofstream(ZoneSet::sidecarPath(zonedMap)) << "corner rect 0 0 1 1\n";
+    fs::path plainMap = testDir / "plain_map.txt";
+    std::ofstream(plainMap) << "012\n345\n6B8\n";
+    fs::path outputFile = testDir / "zones_output.txt";
+
+    Simulation zoned;
+    zoned.loadFromFile(zonedMap);
+    zoned.saveSimulation(outputFile);
+    ASSERT_TRUE(fs::exists(ZoneSet::sidecarPath(outputFile)));
+
+    Simulation plain;
+    plain.loadFromFile(plainMap);
+    plain.saveSimulation(outputFile);
+    EXPECT_TRUE(fs::exists(outputFile));
+    EXPECT_FALSE(fs::exists(ZoneSet::sidecarPath(outputFile)));
+}
+
+TEST_F(SimulationTest, SaveWithoutLandmarksRemovesSidecar) {
+    fs::path landmarkMap = testDir / "landmark_map.txt";
+    std::ofstream(landmarkMap) << "012\n345\n6B8\n";
+    {
+        std::istringstream iss("012\n345\n6B8\n");
+        std::ofstream table(LandmarkTable::sidecarPath(landmarkMap), std::ios::binary);
+        LandmarkTable::build(Map(iss), 2).save(table);
+    }
+    fs::path plainMap = testDir / "plain_map.txt";
+    std::ofstream(plainMap) << "012\n345\n6B8\n";
+    fs::path outputFile = testDir / "landmarks_output.txt";
+
+    Simulation withTable;
+    withTable.loadFromFile(landmarkMap);
+    withTable.saveSimulation(outputFile);
+    ASSERT_TRUE(fs::exists(LandmarkTable::sidecarPath(outputFile)));
+
+    Simulation plain;
+    plain.loadFromFile(plainMap);
+    plain.saveSimulation(outputFile);
+    EXPECT_TRUE(fs::exists(outputFile));
+    EXPECT_FALSE(fs::exists(LandmarkTable::sidecarPath(outputFile)));
+}
+
 // ========== EDGE CASES TESTS ==========
 
 TEST_F(SimulationTest, LoadMapWithOnlyCharger) {
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../Robot/StaticMap.h"
+#include "TestMaps.h"
+
+using namespace TestMaps;
+
+TEST(StaticMapTest, MatchesDynamicMap) {
+    Map map = makeMap(randomMapText(7, 32, 32, true));
+    using Fixed = StaticMap<32, 32>;
+    static_assert(std::is_trivially_copyable_v<Fixed>);
+    static_assert(Fixed::getSize() == 1024);
+    const Fixed fixed = Fixed::fromMap(map);
+    EXPECT_EQ(fixed.getChargerId(), map.getChargerId());
+
+    for (size_t tile = 0; tile < map.getSize(); ++tile) {
+        ASSERT_EQ(fixed.canMoveOn(tile), map.canMoveOn(tile)) << tile;
+        ASSERT_EQ(fixed.getKind(tile), map.getTile(tile)->getKind()) << tile;
+        for (Direction dir : { Direction::up, Direction::down, Direction::left, Direction::right, Direction::none }) {
+            ASSERT_EQ(fixed.getIndex(tile, dir), map.getIndex(tile, dir)) << tile;
+        }
+    }
+    EXPECT_FALSE(fixed.getIndex(1024, Direction::none).has_value());
+
+    std::vector<uint32_t> fixedDistances, mapDistances;
+    std::vector<size_t> queue;
+    breadthFirstDistances(fixed, map.getChargerId(), fixedDistances, queue);
+    breadthFirstDistances(map, map.getChargerId(), mapDistances, queue);
+    EXPECT_EQ(fixedDistances, mapDistances);
+
+    std::ostringstream original, converted;
+    map.saveMap(original);
+    fixed.toMap().saveMap(converted);
+    EXPECT_EQ(converted.str(), original.str());
+}
+
+TEST(StaticMapTest, UpdateCleanAndCopy) {
+    StaticMap<4, 2> fixed;
+    EXPECT_EQ(fixed.getKind(0), TileKind::unvisited);
+    EXPECT_EQ(fixed.getChargerId(), Tile::INVALID_ID);
+    Charger charger;
+    Floor floor(7);
+    EXPECT_TRUE(fixed.updateTile(0, &charger));
+    EXPECT_TRUE(fixed.updateTile(1, &floor));
+    EXPECT_FALSE(fixed.updateTile(1, &floor));
+    EXPECT_THROW(fixed.updateTile(8, &floor), std::out_of_range);
+    EXPECT_EQ(fixed.getChargerId(), 0u);
+    EXPECT_THROW(fixed.updateTile(2, &charger), std::runtime_error);
+    EXPECT_EQ(fixed.getKind(2), TileKind::unvisited);
+
+    StaticMap<4, 2> copy;
+    std::memcpy(static_cast<void*>(&copy), &fixed, sizeof(fixed));
+    fixed.clean(1, 3);
+    EXPECT_EQ(fixed.getCleanliness(1), 4u);
+    EXPECT_EQ(copy.getCleanliness(1), 7u);
+    fixed.clean(1, 9);
+    EXPECT_EQ(fixed.getCleanliness(1), 0u);
+
+    std::vector<size_t> neighbours;
+    fixed.forEachWalkableNeighbour(5, [&](size_t n) { neighbours.push_back(n); });
+    EXPECT_EQ(neighbours, (std::vector<size_t>{ 1 }));
+}
+
+TEST(StaticMapTest, OverwrittenChargerIsForgotten) {
+    StaticMap<4, 2> fixed;
+    Charger charger;
+    Floor floor;
+    fixed.updateTile(3, &charger);
+    EXPECT_FALSE(fixed.updateTile(3, &charger));
+    EXPECT_TRUE(fixed.updateTile(3, &floor));
+    EXPECT_EQ(fixed.getChargerId(), Tile::INVALID_ID);
+
+    // Ładowarka może teraz stanąć gdzie indziej
+    EXPECT_TRUE(fixed.updateTile(6, &charger));
+    EXPECT_EQ(fixed.getChargerId(), 6u);
+    EXPECT_EQ(fixed.toMap().getChargerId(), 6u);
+}
+
+TEST(StaticMapTest, VisitPicksRegisteredSize) {
+    // Ta sama funkcja na obu rodzajach map
+    auto search = [](const auto& grid) {
+        std::vector<uint32_t> dist;
+        std::vector<size_t> queue;
+        breadthFirstDistances(grid, grid.getChargerId(), dist, queue);
+        return std::make_pair(std::is_same_v<std::decay_t<decltype(grid)>, Map>, queue.size());
+    };
+    const Map fixed = makeMap(randomMapText(3, 64, 64, true));
+    const auto [fixedIsMap, fixedReached] = visitGrid(fixed, search);
+    EXPECT_FALSE(fixedIsMap);
+    EXPECT_GT(fixedReached, 1u);
+    const auto [dynamicIsMap, dynamicReached] = visitGrid(makeMap(randomMapText(3, 64, 63, true)), search);
+    EXPECT_TRUE(dynamicIsMap);
+    EXPECT_GT(dynamicReached, 1u);
+
+    std::vector<uint32_t> dist;
+    std::vector<size_t> queue;
+    breadthFirstDistances(fixed, fixed.getChargerId(), dist, queue);
+    EXPECT_EQ(queue.size(), fixedReached);
+
+    EXPECT_THROW((StaticMap<32, 32>::fromMap(makeMap("B0\n"))), std::runtime_error);
+}
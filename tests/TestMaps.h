@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <string>
+#include "../Robot/Robot.h"
+
+// Mapy i roboty wspólne dla testów kilku modułów
+namespace TestMaps {
+    inline Map makeMap(const std::string& text) {
+        std::istringstream iss(text);
+        return Map(iss);
+    }
+
+    // Charger in the top-left corner, a quarter of the other tiles are obstacles.
+    // Floors are clean unless dirty is set, then each gets a random dirt level.
+    inline std::string randomMapText(unsigned seed, size_t width, size_t height, bool dirty = false) {
+        std::mt19937 rng(seed);
+        std::string text;
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                if (x == 0 && y == 0) {
+                    text += 'B';
+                }
+                else if (rng() % 4 == 0) {
+                    text += 'P';
+                }
+                else {
+                    text += dirty ? static_cast<char>('0' + rng() % 10) : '0';
+                }
+            }
+            text += '\n';
+        }
+        return text;
+    }
+
+    inline unsigned int totalDirt(const Map& map) {
+        unsigned int dirt = 0;
+        for (size_t i = 0; i < map.getSize(); ++i) {
+            if (const Floor* floor = map.getTile(i)->asFloor()) {
+                dirt += floor->getCleanliness();
+            }
+        }
+        return dirt;
+    }
+
+    // Robot's memory gets every tile of the world
+    inline void rememberWorld(Robot& robot, const Map& world) {
+        for (size_t id = 0; id < world.getSize(); ++id) {
+            robot.exploreTile(id, world.getTile(id));
+        }
+    }
+
+    // Robot on the charger that already remembers the whole world
+    inline Robot knownRobot(const Map& world) {
+        Robot robot(world.getWidth(), world.getHeight(), world.getChargerId());
+        rememberWorld(robot, world);
+        return robot;
+    }
+
+    // The same robot moved to the given tile first
+    inline Robot knownRobot(const Map& world, size_t position) {
+        Robot robot(world.getWidth(), world.getHeight(), world.getChargerId());
+        robot.setPosition(position);
+        rememberWorld(robot, world);
+        return robot;
+    }
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../Robot/TileBitset.h"
+
+TEST(TileBitsetTest, SetResetAndCount) {
+    TileBitset bits(200);
+    EXPECT_EQ(bits.size(), 200u);
+    EXPECT_TRUE(bits.none());
+
+    bits.set(0);
+    bits.set(63);
+    bits.set(64);
+    bits.set(199);
+    bits.set(64); // Already set
+    EXPECT_EQ(bits.count(), 4u);
+    EXPECT_TRUE(bits[63]);
+    EXPECT_FALSE(bits[62]);
+
+    bits.reset(63);
+    bits.reset(62); // Already clear
+    EXPECT_EQ(bits.count(), 3u);
+    EXPECT_FALSE(bits[63]);
+
+    bits.clear();
+    EXPECT_TRUE(bits.none());
+    for (size_t i = 0; i < bits.size(); ++i) {
+        EXPECT_FALSE(bits[i]);
+    }
+}
+
+TEST(TileBitsetTest, FindNextMatchesLinearScan) {
+    const size_t size = 64 * 64 * 3 + 17;
+    TileBitset bits(size);
+    std::vector<bool> reference(size, false);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<size_t> distrib(0, size - 1);
+    for (int i = 0; i < 50; ++i) {
+        size_t index = distrib(gen);
+        bits.set(index);
+        reference[index] = true;
+    }
+
+    for (size_t from = 0; from < size; from += 37) {
+        size_t expected = TileBitset::npos;
+        for (size_t i = from; i < size; ++i) {
+            if (reference[i]) {
+                expected = i;
+                break;
+            }
+        }
+        EXPECT_EQ(bits.findNext(from), expected) << "from " << from;
+    }
+
+    std::vector<size_t> all;
+    for (size_t i = bits.findNext(0); i != TileBitset::npos; i = bits.findNext(i + 1)) {
+        all.push_back(i);
+    }
+    EXPECT_EQ(all.size(), bits.count());
+    EXPECT_EQ(bits.countRange(0, size), bits.count());
+}
+
+TEST(TileBitsetTest, ClearAfterManyWords) {
+    TileBitset bits(64 * 64 * 2);
+    for (size_t i = 0; i < bits.size(); i += 65) {
+        bits.set(i);
+    }
+    bits.clear();
+    EXPECT_EQ(bits.findNext(0), TileBitset::npos);
+    EXPECT_EQ(bits.countRange(0, bits.size()), 0u);
+
+    bits.set(5000);
+    EXPECT_EQ(bits.findNext(0), 5000u);
+}
+
+TEST(TileBitsetTest, CountRange) {
+    TileBitset bits(300);
+    for (size_t i = 10; i < 250; i += 3) {
+        bits.set(i);
+    }
+    for (size_t begin : {0u, 10u, 11u, 64u, 100u}) {
+        for (size_t end : {11u, 64u, 65u, 128u, 300u}) {
+            size_t expected = 0;
+            for (size_t i = begin; i < end; ++i) {
+                expected += bits[i];
+            }
+            EXPECT_EQ(bits.countRange(begin, end), expected) << begin << ".." << end;
+        }
+    }
+}
+
+TEST(TileBitsetTest, CollectNear) {
+    const size_t width = 100;
+    const size_t height = 50;
+    TileBitset bits(width * height);
+    bits.set(0);                    // (0, 0)
+    bits.set(20 * width + 30);      // (30, 20)
+    bits.set(22 * width + 33);      // (33, 22)
+    bits.set(20 * width + 40);      // (40, 20)
+    bits.set(49 * width + 99);      // (99, 49)
+
+    std::vector<size_t> near;
+    bits.collectNear(21 * width + 31, 3, width, near);
+    std::sort(near.begin(), near.end());
+    EXPECT_EQ(near, (std::vector<size_t>{ 20 * width + 30, 22 * width + 33 }));
+
+    near.clear();
+    bits.collectNear(0, 1, width, near);
+    EXPECT_EQ(near, std::vector<size_t>{ 0 });
+
+    near.clear();
+    bits.collectNear(49 * width + 99, 1000, width, near);
+    EXPECT_EQ(near.size(), bits.count());
+}
+
+TEST(TileBitsetTest, SnapshotRollback) {
+    TileBitset bits(300);
+    bits.set(3);
+    bits.set(250);
+    const size_t outer = bits.snapshot();
+    bits.set(10);
+    bits.reset(3);
+    const size_t inner = bits.snapshot();
+    bits.clear();
+    bits.set(299);
+    EXPECT_EQ(bits.count(), 1u);
+
+    bits.rollback(inner);
+    EXPECT_EQ(bits.count(), 2u);
+    EXPECT_TRUE(bits.test(10));
+    EXPECT_TRUE(bits.test(250));
+    EXPECT_FALSE(bits.test(299));
+
+    bits.rollback(outer);
+    EXPECT_EQ(bits.count(), 2u);
+    EXPECT_TRUE(bits.test(3));
+    EXPECT_FALSE(bits.test(10));
+    EXPECT_EQ(bits.findNext(4), 250u);
+    EXPECT_THROW(bits.assign(10), std::runtime_error);
+
+    bits.commit();
+    EXPECT_THROW(bits.rollback(0), std::runtime_error);
+    bits.assign(10);
+    EXPECT_EQ(bits.size(), 10u);
+}
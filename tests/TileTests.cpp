@@ -22,9 +22,9 @@ protected:
 class FloorTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        cleanFloor = std::make_unique<Floor>(0, 0);
-        dirtyFloor = std::make_unique<Floor>(1, 5);
-        maxDirtyFloor = std::make_unique<Floor>(2, 9);
+        cleanFloor = std::make_unique<Floor>(0);
+        dirtyFloor = std::make_unique<Floor>(5);
+        maxDirtyFloor = std::make_unique<Floor>(9);
     }
 
     std::unique_ptr<Floor> cleanFloor;
@@ -36,7 +36,7 @@ protected:
 class ObstacleTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        obstacle = std::make_unique<Obstacle>(10);
+        obstacle = std::make_unique<Obstacle>();
     }
 
     std::unique_ptr<Obstacle> obstacle;
@@ -46,7 +46,7 @@ protected:
 class ChargerTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        charger = std::make_unique<Charger>(20);
+        charger = std::make_unique<Charger>();
     }
 
     std::unique_ptr<Charger> charger;
@@ -56,7 +56,7 @@ protected:
 class UnVisitedTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        unvisited = std::make_unique<UnVisited>(30);
+        unvisited = std::make_unique<UnVisited>();
     }
 
     std::unique_ptr<UnVisited> unvisited;
@@ -65,13 +65,12 @@ protected:
 // ========== FLOOR TESTS ==========
 
 TEST_F(FloorTest, ConstructorWithValidCleanliness) {
-    Floor floor(5, 3);
-    EXPECT_EQ(floor.getId(), 5);
+    Floor floor(3);
     EXPECT_EQ(floor.getCleanliness(), 3);
 }
 
 TEST_F(FloorTest, ConstructorWithInvalidCleanliness) {
-    Floor floor(5, 15); // Should be capped at 9
+    Floor floor(15); // Should be capped at 9
     EXPECT_EQ(floor.getCleanliness(), 9);
 }
 
@@ -158,18 +157,13 @@ TEST_F(FloorTest, CloneCreatesCorrectCopy) {
 
     ASSERT_NE(clonedFloor, nullptr);
     EXPECT_EQ(clonedFloor->getCleanliness(), dirtyFloor->getCleanliness());
-    EXPECT_EQ(clonedFloor->getId(), dirtyFloor->getId());
 }
 
 // ========== OBSTACLE TESTS ==========
 
-TEST_F(ObstacleTest, ConstructorSetsId) {
-    EXPECT_EQ(obstacle->getId(), 10);
-}
-
 TEST_F(ObstacleTest, DefaultConstructor) {
     Obstacle defaultObstacle;
-    EXPECT_EQ(defaultObstacle.getId(), 0);
+    EXPECT_EQ(defaultObstacle.getKind(), TileKind::obstacle);
 }
 
 TEST_F(ObstacleTest, IsMoveValidAlwaysFalse) {
@@ -181,18 +175,14 @@ TEST_F(ObstacleTest, CloneCreatesCorrectCopy) {
     Obstacle* clonedObstacle = dynamic_cast<Obstacle*>(cloned.get());
 
     ASSERT_NE(clonedObstacle, nullptr);
-    EXPECT_EQ(clonedObstacle->getId(), obstacle->getId());
+    EXPECT_NE(clonedObstacle, obstacle.get());
 }
 
 // ========== CHARGER TESTS ==========
 
-TEST_F(ChargerTest, ConstructorSetsId) {
-    EXPECT_EQ(charger->getId(), 20);
-}
-
 TEST_F(ChargerTest, DefaultConstructor) {
     Charger defaultCharger;
-    EXPECT_EQ(defaultCharger.getId(), 0);
+    EXPECT_EQ(defaultCharger.getKind(), TileKind::charger);
 }
 
 TEST_F(ChargerTest, IsMoveValidAlwaysTrue) {
@@ -204,18 +194,14 @@ TEST_F(ChargerTest, CloneCreatesCorrectCopy) {
     Charger* clonedCharger = dynamic_cast<Charger*>(cloned.get());
 
     ASSERT_NE(clonedCharger, nullptr);
-    EXPECT_EQ(clonedCharger->getId(), charger->getId());
+    EXPECT_NE(clonedCharger, charger.get());
 }
 
 // ========== UNVISITED TESTS ==========
 
-TEST_F(UnVisitedTest, ConstructorSetsId) {
-    EXPECT_EQ(unvisited->getId(), 30);
-}
-
 TEST_F(UnVisitedTest, DefaultConstructor) {
     UnVisited defaultUnvisited;
-    EXPECT_EQ(defaultUnvisited.getId(), 0);
+    EXPECT_EQ(defaultUnvisited.getKind(), TileKind::unvisited);
 }
 
 TEST_F(UnVisitedTest, IsMoveValidAlwaysFalse) {
@@ -227,17 +213,15 @@ TEST_F(UnVisitedTest, CloneCreatesCorrectCopy) {
     UnVisited* clonedUnvisited = dynamic_cast<UnVisited*>(cloned.get());
 
     ASSERT_NE(clonedUnvisited, nullptr);
-    EXPECT_EQ(clonedUnvisited->getId(), unvisited->getId());
+    EXPECT_NE(clonedUnvisited, unvisited.get());
 }
 
 // ========== TILE BASE CLASS TESTS ==========
 
-TEST_F(TileTest, TileIdOperations) {
-    Floor floor(42, 0);
-    EXPECT_EQ(floor.getId(), 42);
-
-    floor.setId(100);
-    EXPECT_EQ(floor.getId(), 100);
+// Numer kafelka wynika z pozycji w mapie, więc obiekt to tylko vptr, rodzaj i brud
+TEST_F(TileTest, TileStoresNoId) {
+    EXPECT_LE(sizeof(Floor), 2 * sizeof(void*));
+    EXPECT_LE(sizeof(Obstacle), 2 * sizeof(void*));
 }
 
 TEST_F(TileTest, InvalidIdConstant) {
@@ -248,10 +232,10 @@ TEST_F(TileTest, InvalidIdConstant) {
 
 TEST_F(TileTest, PolymorphicBehavior) {
     std::vector<std::unique_ptr<Tile>> tiles;
-    tiles.push_back(std::make_unique<Floor>(0, 3));
-    tiles.push_back(std::make_unique<Obstacle>(1));
-    tiles.push_back(std::make_unique<Charger>(2));
-    tiles.push_back(std::make_unique<UnVisited>(3));
+    tiles.push_back(std::make_unique<Floor>(3));
+    tiles.push_back(std::make_unique<Obstacle>());
+    tiles.push_back(std::make_unique<Charger>());
+    tiles.push_back(std::make_unique<UnVisited>());
 
     // Test polymorphic behavior
     EXPECT_TRUE(tiles[0]->isMoveValid());  // Floor
@@ -261,7 +245,7 @@ TEST_F(TileTest, PolymorphicBehavior) {
 }
 
 TEST_F(TileTest, ClonePolymorphism) {
-    std::unique_ptr<Tile> originalFloor = std::make_unique<Floor>(5, 7);
+    std::unique_ptr<Tile> originalFloor = std::make_unique<Floor>(7);
     auto clonedTile = originalFloor->clone();
 
     // Should be able to cast back to Floor
@@ -283,13 +267,13 @@ TEST_F(FloorTest, EdgeCaseZeroEfficiency) {
 }
 
 TEST_F(FloorTest, EdgeCaseMaxDirtiness) {
-    Floor floor(0, 9);
+    Floor floor(9);
     floor.getDirty(1);
     EXPECT_EQ(floor.getCleanliness(), 9); // Should remain at max
 }
 
 TEST_F(FloorTest, RepeatedOperations) {
-    Floor floor(0, 0);
+    Floor floor;
 
     // Make dirty, then clean, repeatedly
     for (int i = 0; i < 5; ++i) {
@@ -304,10 +288,10 @@ TEST_F(FloorTest, RepeatedOperations) {
 // ========== TYPE IDENTIFICATION TESTS ==========
 
 TEST_F(TileTest, TypeIdentificationWithDynamicCast) {
-    std::unique_ptr<Tile> floor = std::make_unique<Floor>(0, 5);
-    std::unique_ptr<Tile> obstacle = std::make_unique<Obstacle>(1);
-    std::unique_ptr<Tile> charger = std::make_unique<Charger>(2);
-    std::unique_ptr<Tile> unvisited = std::make_unique<UnVisited>(3);
+    std::unique_ptr<Tile> floor = std::make_unique<Floor>(5);
+    std::unique_ptr<Tile> obstacle = std::make_unique<Obstacle>();
+    std::unique_ptr<Tile> charger = std::make_unique<Charger>();
+    std::unique_ptr<Tile> unvisited = std::make_unique<UnVisited>();
 
     EXPECT_NE(dynamic_cast<Floor*>(floor.get()), nullptr);
     EXPECT_EQ(dynamic_cast<Obstacle*>(floor.get()), nullptr);
@@ -321,3 +305,45 @@ TEST_F(TileTest, TypeIdentificationWithDynamicCast) {
     EXPECT_NE(dynamic_cast<UnVisited*>(unvisited.get()), nullptr);
     EXPECT_EQ(dynamic_cast<Floor*>(unvisited.get()), nullptr);
 }
+
+TEST_F(TileTest, TypeIdentificationWithKind) {
+    std::unique_ptr<Tile> floor = std::make_unique<Floor>(5);
+    std::unique_ptr<Tile> obstacle = std::make_unique<Obstacle>();
+    std::unique_ptr<Tile> charger = std::make_unique<Charger>();
+    std::unique_ptr<Tile> unvisited = std::make_unique<UnVisited>();
+
+    EXPECT_EQ(floor->getKind(), TileKind::floor);
+    EXPECT_EQ(obstacle->getKind(), TileKind::obstacle);
+    EXPECT_EQ(charger->getKind(), TileKind::charger);
+    EXPECT_EQ(unvisited->getKind(), TileKind::unvisited);
+
+    EXPECT_EQ(floor->clone()->getKind(), TileKind::floor);
+    EXPECT_EQ(charger->clone()->getKind(), TileKind::charger);
+}
+
+TEST_F(TileTest, AsFloorMatchesDynamicCast) {
+    std::unique_ptr<Tile> floor = std::make_unique<Floor>(5);
+    std::unique_ptr<Tile> obstacle = std::make_unique<Obstacle>();
+    std::unique_ptr<Tile> charger = std::make_unique<Charger>();
+    std::unique_ptr<Tile> unvisited = std::make_unique<UnVisited>();
+
+    EXPECT_EQ(floor->asFloor(), dynamic_cast<Floor*>(floor.get()));
+    EXPECT_EQ(floor->asFloor()->getCleanliness(), 5u);
+    EXPECT_EQ(obstacle->asFloor(), nullptr);
+    EXPECT_EQ(charger->asFloor(), nullptr);
+    EXPECT_EQ(unvisited->asFloor(), nullptr);
+}
+
+TEST_F(TileTest, IsWalkableMatchesIsMoveValid) {
+    std::unique_ptr<Tile> tiles[] = {
+        std::make_unique<Floor>(5),
+        std::make_unique<Obstacle>(),
+        std::make_unique<Charger>(),
+        std::make_unique<UnVisited>()
+    };
+
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(tile->isWalkable(), tile->isMoveValid());
+        EXPECT_EQ(tile->isFloor(), tile->getKind() == TileKind::floor);
+    }
+}
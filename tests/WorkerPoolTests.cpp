@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include "../Robot/WorkerPool.h"
+
+TEST(WorkerPoolTest, ReusesThreadsBetweenRuns) {
+    WorkerPool pool;
+    std::atomic<unsigned> calls{ 0 };
+    std::atomic<unsigned> workerSum{ 0 };
+    for (int run = 0; run < 3; ++run) {
+        pool.run(4, [&](unsigned worker) {
+            calls++;
+            workerSum += worker;
+        });
+    }
+    EXPECT_EQ(calls.load(), 12u);
+    EXPECT_EQ(workerSum.load(), 18u);
+    EXPECT_EQ(pool.threadCount(), 3u);
+
+    // Mniej wykonawców niż wątków: pozostałe wątki nie dostają zadania
+    calls = 0;
+    pool.run(2, [&](unsigned worker) {
+        EXPECT_LT(worker, 2u);
+        calls++;
+    });
+    EXPECT_EQ(calls.load(), 2u);
+    EXPECT_EQ(pool.threadCount(), 3u);
+}
+
+TEST(WorkerPoolTest, RethrowsAfterAllWorkersFinish) {
+    WorkerPool pool;
+    std::atomic<unsigned> finished{ 0 };
+    EXPECT_THROW(pool.run(3, [&](unsigned worker) {
+        if (worker == 2) {
+            throw std::runtime_error("worker failed");
+        }
+        finished++;
+    }), std::runtime_error);
+    EXPECT_EQ(finished.load(), 2u);
+
+    // Pula działa dalej po błędzie
+    pool.run(3, [&](unsigned) { finished++; });
+    EXPECT_EQ(finished.load(), 5u);
+}